@@ -26,6 +26,7 @@
 
 #include <cerrno>
 #include <fcntl.h>
+#include <map>
 #include <golded.h>
 #include <gmoprot.h>
 #include "geglob.h"
@@ -66,6 +67,12 @@ AreaList::AreaList() : idx()
     item = idx.begin();
     *sortspec = NUL;
 
+    goldlastvalid = false;
+    goldlastareas = 0;
+    goldlastsel = 0;
+
+    echoindexed = 0;
+
     for(uint i = 0; i < 16; i++)
         *alistselections[0] = NUL;
 }
@@ -105,6 +112,43 @@ void AreaList::Reset()
         delete idx.back();
         idx.pop_back();
     }
+    EchoIndexReset();
+}
+
+
+//  ------------------------------------------------------------------
+//  Find an area by echoid. Areas added since the last call are
+//  indexed first; the first area with a given echoid wins.
+
+Area* AreaList::EchoIndexFind(const char* echoid)
+{
+
+    std::string key;
+
+    if(echoindexed > idx.size())
+        EchoIndexReset();
+
+    for(; echoindexed < idx.size(); echoindexed++)
+    {
+        key = idx[echoindexed]->echoid();
+        strupr(key);
+        echoindex.insert(std::pair<std::string, Area*>(key, idx[echoindexed]));
+    }
+
+    key = echoid;
+    strupr(key);
+    std::map<std::string, Area*>::iterator it = echoindex.find(key);
+    return (it != echoindex.end()) ? it->second : (Area*)NULL;
+}
+
+
+//  ------------------------------------------------------------------
+
+void AreaList::EchoIndexReset()
+{
+
+    echoindex.clear();
+    echoindexed = 0;
 }
 
 
@@ -152,6 +196,47 @@ Area* AreaList::NewArea(const std::string &basetype)
     return NewArea(basetype.c_str());
 }
 
+//  ------------------------------------------------------------------
+//  Fill GOLDLAST.LST entry for the area
+
+void AreaList::GoldLastEntry(Area* ap, ggoldlast& entry)
+{
+    memset(&entry, 0, sizeof(entry));
+    entry.crcechoid    = strCrc32(ap->echoid(), false);
+    entry.lastread     = ap->lastread();
+    entry.msgncount    = ap->Msgn.Count();
+    entry.unread       = ap->unread;
+    entry.marks        = ap->marks;
+    entry.flags        = 0;
+    if(ap->isscanned)
+        entry.flags |= 1;
+    if(ap->isvalidchg)
+        entry.flags |= 2;
+    if(ap->isunreadchg)
+        entry.flags |= 4;
+}
+
+
+//  ------------------------------------------------------------------
+//  Checksum of the area state stored in GOLDLAST.LST
+
+dword AreaList::GoldLastState(const ggoldlast& entry, Area* ap)
+{
+    dword val, crc = memCrc32(&entry, sizeof(entry), false, CRC32_MASK_CCITT);
+
+    val = (dword)ap->Mark.Count();
+    crc = memCrc32(crc, &val, sizeof(val), false, CRC32_MASK_CCITT);
+    if(ap->Mark.tag and val)
+        crc = memCrc32(crc, ap->Mark.tag, val*sizeof(uint32_t), false, CRC32_MASK_CCITT);
+    val = (dword)ap->PMrk.Count();
+    crc = memCrc32(crc, &val, sizeof(val), false, CRC32_MASK_CCITT);
+    if(ap->PMrk.tag and val)
+        crc = memCrc32(crc, ap->PMrk.tag, val*sizeof(uint32_t), false, CRC32_MASK_CCITT);
+
+    return crc ^ CRC32_MASK_CCITT;
+}
+
+
 //  ------------------------------------------------------------------
 //  Write lastreads for the next session
 
@@ -159,17 +244,40 @@ void AreaList::WriteGoldLast()
 {
     word GOLDLAST_VER = CUR_GOLDLAST_VER;
     ggoldlast entry;
-    Path lst;
+    Path lst, tmp;
+
+    // Nothing to do if all areas are exactly as they were loaded
+    if(goldlastvalid)
+    {
+        uint areas = 0;
+        bool changed = make_bool(goldlastsel != memCrc32(alistselections, sizeof(alistselections), false));
+
+        for(area_iterator ap = idx.begin(); (ap != idx.end()) and not changed; ap++)
+        {
+            if((*ap)->isscanned and not (*ap)->isseparator())
+            {
+                GoldLastEntry(*ap, entry);
+                if(((*ap)->goldlast == 0) or ((*ap)->goldlast != GoldLastState(entry, *ap)))
+                    changed = true;
+                areas++;
+            }
+        }
+
+        if(not changed and (areas == goldlastareas))
+            return;
+    }
 
     strcpy(lst, AddPath(CFG->goldpath, CFG->goldlast));
+    replaceextension(tmp, lst, ".tmp");
 
-    gfile fp(lst, "wb", CFG->sharemode);
+    gfile fp(tmp, "wb", CFG->sharemode);
     if (fp.isopen())
     {
-        fp.SetvBuf(NULL, _IOFBF, 8192);
+        fp.SetvBuf(NULL, _IOFBF, 65535);
         fp.Fwrite(&GOLDLAST_VER, sizeof(word));
         fp.Fwrite(AL.alistselections, sizeof(AL.alistselections));
 
+        goldlastareas = 0;
         for(area_iterator ap = idx.begin(); ap != idx.end(); ap++)
         {
 
@@ -177,26 +285,56 @@ void AreaList::WriteGoldLast()
             {
 
                 // Write fixed header
-                entry.crcechoid    = strCrc32((*ap)->echoid(), false);
-                entry.lastread     = (*ap)->lastread();
-                entry.msgncount    = (*ap)->Msgn.Count();
-                entry.unread       = (*ap)->unread;
-                entry.marks        = (*ap)->marks;
-                entry.flags        = 0;
-                if((*ap)->isscanned)
-                    entry.flags |= 1;
-                if((*ap)->isvalidchg)
-                    entry.flags |= 2;
-                if((*ap)->isunreadchg)
-                    entry.flags |= 4;
-
+                GoldLastEntry(*ap, entry);
                 fp.Fwrite(&entry, sizeof(entry));
 
                 // Write variable length extensions
                 (*ap)->Mark.Save(fp);
                 (*ap)->PMrk.Save(fp);
+
+                (*ap)->goldlast = GoldLastState(entry, *ap);
+                goldlastareas++;
             }
         }
+
+        bool ok = (fp.Fflush() == 0) and fp.okay();
+        fp.Fclose();
+
+        // Replace the old file only when the new one is complete
+        if(not ok)
+        {
+            remove(tmp);
+            goldlastvalid = false;
+            return;
+        }
+
+#if defined(__UNIX__)
+        ok = (rename(tmp, lst) == 0);
+#else
+        // rename() cannot replace a file here, so move the old one aside
+        // and put it back if the new one cannot take its place
+        Path bak;
+        replaceextension(bak, lst, ".bak");
+        remove(bak);
+        bool saved = (rename(lst, bak) == 0);
+        ok = (rename(tmp, lst) == 0);
+        if(saved)
+        {
+            if(ok)
+                remove(bak);
+            else
+                rename(bak, lst);
+        }
+#endif
+
+        // If the rename failed, the complete new file is kept in tmp
+        if(ok)
+        {
+            goldlastsel = memCrc32(alistselections, sizeof(alistselections), false);
+            goldlastvalid = true;
+        }
+        else
+            goldlastvalid = false;
     }
 }
 
@@ -212,50 +350,100 @@ void AreaList::ReadGoldLast()
     gfile fp(AddPath(CFG->goldpath, CFG->goldlast), "rb", CFG->sharemode);
     if (fp.isopen())
     {
-        fp.SetvBuf(NULL, _IOFBF, 8192);
-        fp.Fread(&GOLDLAST_VER, sizeof(word));
-
-        if (GOLDLAST_VER != CUR_GOLDLAST_VER)
+        long len = fp.FileLength();
+        if (len < (long)(sizeof(word) + sizeof(AL.alistselections)))
             return;
 
-        fp.Fread(AL.alistselections, sizeof(AL.alistselections));
+        // Slurp the whole file at once and parse it from memory
+        byte* buf = (byte*)throw_malloc(len);
+        bool ok = (fp.Fread(buf, len) == 1);
+        fp.Fclose();
+
+        const byte* ptr = buf;
+        const byte* end = buf + len;
+
+        memcpy(&GOLDLAST_VER, ptr, sizeof(word));
+        ptr += sizeof(word);
 
-        while (fp.Fread(&entry, sizeof(entry)))
+        if (not ok or (GOLDLAST_VER != CUR_GOLDLAST_VER))
         {
-            bool found = false;
+            throw_free(buf);
+            return;
+        }
 
-            for(area_iterator ap = idx.begin(); ap != idx.end(); ap++)
-            {
-                if(strCrc32((*ap)->echoid(), false) == entry.crcechoid)
-                {
+        memcpy(AL.alistselections, ptr, sizeof(AL.alistselections));
+        ptr += sizeof(AL.alistselections);
 
-                    (*ap)->set_lastread(entry.lastread);
-                    (*ap)->Msgn.count  = entry.msgncount;
-                    (*ap)->unread      = entry.unread;
-                    (*ap)->marks       = entry.marks;
-                    (*ap)->isscanned   = make_bool(entry.flags & 1);
-                    (*ap)->isvalidchg  = make_bool(entry.flags & 2);
-                    (*ap)->UpdateAreadata();
-                    (*ap)->isunreadchg = make_bool(entry.flags & 4);
+        // Index areas by echoid CRC; the first area with a given CRC wins
+        std::map<dword, Area*> crcidx;
+        for(area_iterator ap = idx.begin(); ap != idx.end(); ap++)
+        {
+            (*ap)->goldlast = 0;
+            crcidx.insert(std::pair<dword, Area*>(strCrc32((*ap)->echoid(), false), *ap));
+        }
 
-                    (*ap)->Mark.Load(fp);
-                    (*ap)->PMrk.Load(fp);
+        goldlastareas = 0;
+        goldlastvalid = true;
 
-                    found = true;
-                    break;
+        while (ptr and ((end - ptr) >= (long)sizeof(entry)))
+        {
+            memcpy(&entry, ptr, sizeof(entry));
+            ptr += sizeof(entry);
+
+            std::map<dword, Area*>::iterator it = crcidx.find(entry.crcechoid);
+            if (it != crcidx.end())
+            {
+                Area* ap = it->second;
+
+                ap->set_lastread(entry.lastread);
+                ap->Msgn.count  = entry.msgncount;
+                ap->unread      = entry.unread;
+                ap->marks       = entry.marks;
+                ap->isscanned   = make_bool(entry.flags & 1);
+                ap->isvalidchg  = make_bool(entry.flags & 2);
+                ap->UpdateAreadata();
+                ap->isunreadchg = make_bool(entry.flags & 4);
+
+                ptr = ap->Mark.Load(ptr, end);
+                if (ptr)
+                    ptr = ap->PMrk.Load(ptr, end);
+
+                if (ptr and (ap->goldlast == 0))
+                {
+                    ap->goldlast = GoldLastState(entry, ap);
+                    goldlastareas++;
                 }
+                else
+                    goldlastvalid = false;
             }
-
-            if (not found)
+            else
             {
                 // skip stored message marks
-                dword dw;
-                fp.Fread(&dw, sizeof(dword));
-                fp.Fseek(dw*sizeof(dword), SEEK_CUR);
-                fp.Fread(&dw, sizeof(dword));
-                fp.Fseek(dw*sizeof(dword), SEEK_CUR);
+                for (int n = 0; ptr and (n < 2); n++)
+                {
+                    dword dw;
+                    if ((end - ptr) < (long)sizeof(dword))
+                        ptr = NULL;
+                    else
+                    {
+                        memcpy(&dw, ptr, sizeof(dword));
+                        ptr += sizeof(dword);
+                        if ((dword)(end - ptr) / sizeof(dword) < dw)
+                            ptr = NULL;
+                        else
+                            ptr += dw*sizeof(dword);
+                    }
+                }
+                goldlastvalid = false;
             }
         }
+
+        if (ptr != end)
+            goldlastvalid = false;
+
+        goldlastsel = memCrc32(alistselections, sizeof(alistselections), false);
+
+        throw_free(buf);
     }
 }
 
@@ -382,6 +570,7 @@ void AreaList::WriteAreaDef(const char* file)
 void SetAreaDesc(char* echoid, char* desc)
 {
 
+    GAreafileEvent event(AFC_AREADESC, echoid, desc);
     AL.SetAreaDesc(echoid, desc);
 }
 
@@ -391,14 +580,9 @@ void SetAreaDesc(char* echoid, char* desc)
 void AreaList::SetAreaDesc(char* echoid, char* desc)
 {
 
-    for(area_iterator ap = idx.begin(); ap != idx.end(); ap++)
-    {
-        if(strieql(echoid, (*ap)->echoid()))
-        {
-            (*ap)->set_desc(desc);
-            break;
-        }
-    }
+    Area* ap = EchoIndexFind(echoid);
+    if(ap)
+        ap->set_desc(desc);
 }
 
 
@@ -24,6 +24,8 @@
 //  Common code for the area compile.
 //  ------------------------------------------------------------------
 
+#include <algorithm>
+#include <sys/stat.h>
 #include <golded.h>
 #include <gmoprot.h>
 
@@ -163,6 +165,7 @@ void CheckEMailOrNews(char* echoid, uint& type)
 void AddNewArea(AreaCfg* aa)
 {
 
+    GAreafileEvent event(*aa);
     AL.AddNewArea(aa);
 }
 
@@ -173,10 +176,24 @@ void AddNewArea(AreaCfg* aa)
 void AddNewArea(AreaCfg& aa)
 {
 
+    GAreafileEvent event(aa);
     AL.AddNewArea(&aa);
 }
 
 
+//  ------------------------------------------------------------------
+//  Set an environment variable for the areafile readers ("NAME=value")
+
+void SetEnviron(const char* value)
+{
+
+    GAreafileEvent event(AFC_SETENV, value);
+    char* memory = static_cast<char*>(malloc(strlen(value)+1));
+    strcpy(memory, value);
+    putenv(memory);
+}
+
+
 //  ------------------------------------------------------------------
 //  Add or update area data
 
@@ -439,6 +456,90 @@ void AreaList::AddNewArea(AreaCfg* aa)
 }
 
 
+//  ------------------------------------------------------------------
+//  Make the snapshot key: the directive and all settings the
+//  areafile readers depend on
+
+static std::string AreafileKey(word crcval, const char* value)
+{
+    std::string key, tmp;
+    char buf[64];
+
+    gsprintf(PRINTF_DECLARE_BUFFER(buf), "%04X %d %d %d\n", crcval, AFILE->ra2usersbbs, AFILE->squishuserno, CFG->areaautoid);
+    key = buf;
+    key += value;
+    key += '\n';
+    key += AFILE->fidomsgtype;
+    key += '\n';
+    key += AFILE->areapath;
+    key += '\n';
+    key += AFILE->pcboardpath;
+    key += '\n';
+    key += AFILE->primary_aka.make_string(tmp);
+    key += '\n';
+    key += AFILE->attribsnet.make_string(tmp);
+    key += '\n';
+    key += AFILE->attribsecho.make_string(tmp);
+    key += '\n';
+    key += AFILE->attribsnews.make_string(tmp);
+    key += '\n';
+    key += AFILE->attribsemail.make_string(tmp);
+    key += '\n';
+    key += AFILE->attribslocal.make_string(tmp);
+
+    // The readers look for their files through the environment
+    static const char* const envnames[] =
+    {
+        "DB", "DBRIDGE", "DUTCHIE", "EZY", "FASTECHO", "FD", "FIDOCONFIG",
+        "FIDOPCB", "FMAIL", "GE", "IM", "IMAIL", "LORA", "LORABBS",
+        "MAXIMUS", "OPUS", "PB", "PCBOARD", "POPCMDLINE", "QBBS", "QFRONT",
+        "QUICKBBS", "RA", "RAECHO", "SBBS", "SQUISH", "SUPERBBS", "TASK",
+        "TIMED", "TMAIL", "WMAIL", "WTRGATE", "XM", NULL
+    };
+    for(int n = 0; envnames[n]; n++)
+    {
+        const char* env = getenv(envnames[n]);
+        key += '\n';
+        if(env)
+        {
+            key += '=';
+            key += env;
+        }
+    }
+
+    // ...and expand environment references in their arguments
+    tmp = value;
+    strschg_environ(tmp);
+    key += '\n';
+    key += tmp;
+
+    // Paths they report are mapped through MAPPATH
+    std::vector< std::pair<std::string, std::string> >::iterator map;
+    for(map = CFG->mappath.begin(); map != CFG->mappath.end(); map++)
+    {
+        key += '\n';
+        key += map->first;
+        key += '=';
+        key += map->second;
+    }
+
+    // AREAS.BBS readers look up descriptions in the ME2 desclist
+    dword crc = CRC32_MASK_CCITT;
+    for(int n = 0; n < AFILE->echolist.Descs(); n++)
+    {
+        char* echoid;
+        char* desc;
+        AFILE->echolist.GetDesc(n, &echoid, &desc);
+        crc = strCrc32(echoid, false, crc);
+        crc = strCrc32(desc, false, crc);
+    }
+    gsprintf(PRINTF_DECLARE_BUFFER(buf), "\n%08X", crc);
+    key += buf;
+
+    return key;
+}
+
+
 //  ------------------------------------------------------------------
 //  Get areas from other programs
 
@@ -480,7 +581,13 @@ void AreaList::GetAreafile(char* value)
         AFILE->attribsemail = CFG->attribsemail;
         AFILE->attribslocal = CFG->attribslocal;
 
-        AFILE->ReadAreafile(crcval, value);
+        std::string key = AreafileKey(crcval, value);
+        if(not AFC.Replay(key))
+        {
+            AFC.Begin(key);
+            AFILE->ReadAreafile(crcval, value);
+            AFC.End();
+        }
 
         CFG->ra2usersbbs = AFILE->ra2usersbbs;
         CFG->squishuserno = AFILE->squishuserno;
@@ -493,6 +600,609 @@ void AreaList::GetAreafile(char* value)
 }
 
 
+//  ------------------------------------------------------------------
+//  Areafile snapshot
+
+GAreafileCache AFC;
+
+
+//  ------------------------------------------------------------------
+
+GAreafileCache::GAreafileCache()
+{
+
+    current = -1;
+    nested = false;
+    loaded = false;
+    dirty = false;
+    echostart = descstart = 0;
+}
+
+
+//  ------------------------------------------------------------------
+
+void GAreafileCache::Filename(char* file)
+{
+
+    Path name;
+    strxmerge(name, sizeof(Path), "goldarea", __gver_cfgext__, NULL);
+    strxcpy(file, AddPath(CFG->goldpath, name), sizeof(Path));
+}
+
+
+//  ------------------------------------------------------------------
+//  Helpers for the snapshot file layout
+
+static void PutDword(std::string& buf, dword val)
+{
+    buf.append((const char*)&val, sizeof(dword));
+}
+
+static void PutString(std::string& buf, const std::string& str)
+{
+    PutDword(buf, (dword)str.length());
+    buf.append(str);
+}
+
+static bool GetDword(const byte*& ptr, const byte* end, dword& val)
+{
+    if((end - ptr) < (long)sizeof(dword))
+        return false;
+    memcpy(&val, ptr, sizeof(dword));
+    ptr += sizeof(dword);
+    return true;
+}
+
+static bool GetString(const byte*& ptr, const byte* end, std::string& str)
+{
+    dword len;
+    if(not GetDword(ptr, end, len) or ((dword)(end - ptr) < len))
+        return false;
+    str.assign((const char*)ptr, len);
+    ptr += len;
+    return true;
+}
+
+static bool GetString(const byte*& ptr, const byte* end, char* str, size_t size)
+{
+    std::string tmp;
+    if(not GetString(ptr, end, tmp))
+        return false;
+    strxcpy(str, tmp.c_str(), size);
+    return true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Load the snapshot from the previous session
+
+void GAreafileCache::Load()
+{
+
+    Path file;
+
+    loaded = true;
+    entries.clear();
+
+    Filename(file);
+    gfile fp(file, "rb", CFG->sharemode);
+    if(not fp.isopen())
+        return;
+
+    long len = fp.FileLength();
+    if(len < (long)(sizeof(word)+sizeof(dword)))
+        return;
+
+    byte* buf = (byte*)throw_malloc(len);
+    bool ok = (fp.Fread(buf, len) == 1);
+    fp.Fclose();
+
+    const byte* ptr = buf;
+    const byte* end = buf + len;
+    word ver = 0;
+    dword count = 0, n, i, val = 0;
+
+    memcpy(&ver, ptr, sizeof(word));
+    ptr += sizeof(word);
+    ok = ok and (ver == CUR_GOLDAREA_VER) and GetDword(ptr, end, count);
+
+    // Every value is checked as soon as it is read, and reading stops
+    // at the first one that is missing or out of range
+    for(n = 0; ok and (n < count); n++)
+    {
+        entries.push_back(Entry());
+        Entry& entry = entries.back();
+        entry.used = false;
+
+        dword ra2usersbbs = 0, squishuserno = 0;
+        ok = GetString(ptr, end, entry.key)
+             and GetDword(ptr, end, ra2usersbbs)
+             and GetDword(ptr, end, squishuserno)
+             and GetDword(ptr, end, val);
+        entry.ra2usersbbs = (int)ra2usersbbs;
+        entry.squishuserno = (int)squishuserno;
+
+        for(i = 0; ok and (i < val); i++)
+        {
+            Stamp stamp;
+            dword size = 0, mtime = 0;
+            ok = GetString(ptr, end, stamp.path) and GetDword(ptr, end, size) and GetDword(ptr, end, mtime);
+            if(not ok)
+                break;
+            stamp.size = (long)(int32_t)size;
+            stamp.mtime = mtime;
+            entry.stamps.push_back(stamp);
+        }
+
+        ok = ok and GetDword(ptr, end, val);
+        for(i = 0; ok and (i < val); i++)
+        {
+            EchoList echo;
+            ok = GetString(ptr, end, echo.echoid, sizeof(echo.echoid))
+                 and GetString(ptr, end, echo.path, sizeof(echo.path))
+                 and GetString(ptr, end, echo.desc, sizeof(echo.desc));
+            if(not ok)
+                break;
+            entry.echos.push_back(echo);
+        }
+
+        ok = ok and GetDword(ptr, end, val);
+        for(i = 0; ok and (i < val); i++)
+        {
+            DescList desc;
+            ok = GetString(ptr, end, desc.echoid, sizeof(desc.echoid))
+                 and GetString(ptr, end, desc.desc, sizeof(desc.desc));
+            if(not ok)
+                break;
+            entry.descs.push_back(desc);
+        }
+
+        ok = ok and GetDword(ptr, end, val);
+        for(i = 0; ok and (i < val); i++)
+        {
+            AreaCfg aa;
+            dword groupid = 0, board = 0, type = 0, flags = 0;
+            dword addr1 = 0, addr2 = 0, attr1 = 0, attr2 = 0;
+
+            ok = GetString(ptr, end, aa.echoid, sizeof(aa.echoid))
+                 and GetString(ptr, end, aa.desc, sizeof(aa.desc))
+                 and GetString(ptr, end, aa.path, sizeof(aa.path))
+                 and GetString(ptr, end, aa.origin)
+                 and GetString(ptr, end, aa.basetype)
+                 and GetDword(ptr, end, groupid)
+                 and GetDword(ptr, end, board)
+                 and GetDword(ptr, end, type)
+                 and GetDword(ptr, end, flags)
+                 and GetDword(ptr, end, addr1)
+                 and GetDword(ptr, end, addr2)
+                 and GetDword(ptr, end, attr1)
+                 and GetDword(ptr, end, attr2);
+            if(not ok)
+                break;
+
+            aa.groupid = (int)groupid;
+            aa.board = (uint)board;
+            aa.type = (uint)type;
+            aa.scan       = make_bool(flags & 0x01);
+            aa.scanexcl   = make_bool(flags & 0x02);
+            aa.scanincl   = make_bool(flags & 0x04);
+            aa.pmscan     = make_bool(flags & 0x08);
+            aa.pmscanexcl = make_bool(flags & 0x10);
+            aa.pmscanincl = make_bool(flags & 0x20);
+            aa.aka.zone  = (word)(addr1 >> 16);
+            aa.aka.net   = (word)(addr1 & 0xFFFF);
+            aa.aka.node  = (word)(addr2 >> 16);
+            aa.aka.point = (word)(addr2 & 0xFFFF);
+            aa.attr.set_words(attr1, attr2);
+
+            entry.areas.push_back(aa);
+        }
+
+        ok = ok and GetDword(ptr, end, val);
+        for(i = 0; ok and (i < val); i++)
+        {
+            Event event;
+            dword code = 0, num = 0, echos = 0, descs = 0;
+            ok = GetDword(ptr, end, code)
+                 and GetDword(ptr, end, num)
+                 and GetString(ptr, end, event.s1)
+                 and GetString(ptr, end, event.s2)
+                 and GetDword(ptr, end, echos)
+                 and GetDword(ptr, end, descs);
+            if(not ok)
+                break;
+            event.code = (int)code;
+            event.n = (int)num;
+            event.echos = echos;
+            event.descs = descs;
+            if((event.echos > entry.echos.size()) or (event.descs > entry.descs.size()))
+                ok = false;
+            else if((event.code == AFC_AREA) and ((event.n < 0) or ((uint)event.n >= entry.areas.size())))
+                ok = false;
+            else
+                entry.events.push_back(event);
+        }
+    }
+
+    if(not ok or (ptr != end))
+        entries.clear();
+
+    throw_free(buf);
+}
+
+
+//  ------------------------------------------------------------------
+//  Write the snapshot with the entries used in this session
+
+void GAreafileCache::Save()
+{
+
+    Path file;
+    std::string buf;
+    dword count = 0;
+
+    std::vector<Entry>::iterator entry;
+    for(entry = entries.begin(); entry != entries.end(); entry++)
+    {
+        if(entry->used)
+            count++;
+        else
+            dirty = true;
+    }
+
+    if(not dirty)
+        return;
+
+    Filename(file);
+    dirty = false;
+
+    if(count == 0)
+    {
+        entries.clear();
+        remove(file);
+        return;
+    }
+
+    word ver = CUR_GOLDAREA_VER;
+    buf.append((const char*)&ver, sizeof(word));
+    PutDword(buf, count);
+
+    for(entry = entries.begin(); entry != entries.end(); )
+    {
+        if(not entry->used)
+        {
+            entry = entries.erase(entry);
+            continue;
+        }
+
+        PutString(buf, entry->key);
+        PutDword(buf, (dword)entry->ra2usersbbs);
+        PutDword(buf, (dword)entry->squishuserno);
+
+        PutDword(buf, (dword)entry->stamps.size());
+        for(std::vector<Stamp>::iterator i = entry->stamps.begin(); i != entry->stamps.end(); i++)
+        {
+            PutString(buf, i->path);
+            PutDword(buf, (dword)i->size);
+            PutDword(buf, i->mtime);
+        }
+
+        PutDword(buf, (dword)entry->echos.size());
+        for(std::vector<EchoList>::iterator i = entry->echos.begin(); i != entry->echos.end(); i++)
+        {
+            PutString(buf, i->echoid);
+            PutString(buf, i->path);
+            PutString(buf, i->desc);
+        }
+
+        PutDword(buf, (dword)entry->descs.size());
+        for(std::vector<DescList>::iterator i = entry->descs.begin(); i != entry->descs.end(); i++)
+        {
+            PutString(buf, i->echoid);
+            PutString(buf, i->desc);
+        }
+
+        PutDword(buf, (dword)entry->areas.size());
+        for(std::vector<AreaCfg>::iterator i = entry->areas.begin(); i != entry->areas.end(); i++)
+        {
+            dword flags = 0;
+            if(i->scan)        flags |= 0x01;
+            if(i->scanexcl)    flags |= 0x02;
+            if(i->scanincl)    flags |= 0x04;
+            if(i->pmscan)      flags |= 0x08;
+            if(i->pmscanexcl)  flags |= 0x10;
+            if(i->pmscanincl)  flags |= 0x20;
+
+            PutString(buf, i->echoid);
+            PutString(buf, i->desc);
+            PutString(buf, i->path);
+            PutString(buf, i->origin);
+            PutString(buf, i->basetype);
+            PutDword(buf, (dword)i->groupid);
+            PutDword(buf, (dword)i->board);
+            PutDword(buf, (dword)i->type);
+            PutDword(buf, flags);
+            PutDword(buf, ((dword)i->aka.zone << 16) | i->aka.net);
+            PutDword(buf, ((dword)i->aka.node << 16) | i->aka.point);
+            PutDword(buf, i->attr.word1());
+            PutDword(buf, i->attr.word2());
+        }
+
+        PutDword(buf, (dword)entry->events.size());
+        for(std::vector<Event>::iterator i = entry->events.begin(); i != entry->events.end(); i++)
+        {
+            PutDword(buf, (dword)i->code);
+            PutDword(buf, (dword)i->n);
+            PutString(buf, i->s1);
+            PutString(buf, i->s2);
+            PutDword(buf, i->echos);
+            PutDword(buf, i->descs);
+        }
+
+        entry->used = false;
+        entry++;
+    }
+
+    gfile fp(file, "wb", CFG->sharemode);
+    if(fp.isopen())
+    {
+        fp.Fwrite(buf.data(), buf.length());
+        if(not fp.okay())
+        {
+            fp.Fclose();
+            remove(file);
+        }
+    }
+}
+
+
+//  ------------------------------------------------------------------
+//  Check if any file the entry was made from has changed
+
+bool GAreafileCache::Stale(const Entry& entry)
+{
+
+    std::vector<Stamp>::const_iterator i;
+    for(i = entry.stamps.begin(); i != entry.stamps.end(); i++)
+    {
+        struct stat st;
+        if(stat(i->path.c_str(), &st) == 0)
+        {
+            if((i->size != (long)st.st_size) or (i->mtime != (dword)st.st_mtime))
+                return true;
+        }
+        else if(i->size != -1)
+            return true;
+    }
+
+    return false;
+}
+
+
+//  ------------------------------------------------------------------
+//  Restore echolist entries the reader had added up to this point
+
+void GAreafileCache::Sync(const Entry& entry, uint& echos, uint& descs, uint toechos, uint todescs)
+{
+
+    for(; echos < toechos; echos++)
+    {
+        const EchoList& e = entry.echos[echos];
+        AFILE->echolist.AppendEcho(e.echoid, e.path, e.desc);
+    }
+    for(; descs < todescs; descs++)
+    {
+        DescList d = entry.descs[descs];
+        AFILE->echolist.AddDesc(d.echoid, d.desc);
+    }
+}
+
+
+//  ------------------------------------------------------------------
+//  Repeat the callbacks of an unchanged areafile from the snapshot.
+//  Returns false if there is no usable snapshot entry.
+
+bool GAreafileCache::Replay(const std::string& key)
+{
+
+    if(not loaded)
+        Load();
+
+    std::vector<Entry>::iterator entry;
+    for(entry = entries.begin(); entry != entries.end(); entry++)
+    {
+        if(entry->key == key)
+            break;
+    }
+
+    if((entry == entries.end()) or Stale(*entry))
+        return false;
+
+    if(not quiet)
+    {
+        Path file;
+        Filename(file);
+        STD_PRINTNL("* Reading " << file);
+    }
+
+    uint echos = 0, descs = 0;
+    char buf[256], buf2[256];
+
+    std::vector<Event>::const_iterator i;
+    for(i = entry->events.begin(); i != entry->events.end(); i++)
+    {
+        Sync(*entry, echos, descs, i->echos, i->descs);
+
+        strxcpy(buf, i->s1.c_str(), sizeof(buf));
+        strxcpy(buf2, i->s2.c_str(), sizeof(buf2));
+
+        switch(i->code)
+        {
+        case AFC_AREA:
+            {
+                AreaCfg aa;
+                aa = entry->areas[i->n];
+                aa.originno = 0;
+                if(not strblank(aa.origin.c_str()))
+                    aa.AreaCfgBase::setorigin(aa.origin);
+                AddNewArea(aa);
+            }
+            break;
+        case AFC_ADDRESS:           CfgAddress(buf);                      break;
+        case AFC_ORIGIN:            CfgOrigin(buf);                       break;
+        case AFC_USERNAME:          CfgUsername(buf);                     break;
+        case AFC_JAMSMAPIHIGHWATER: CfgJAMSMAPIHighwater(make_bool(i->n)); break;
+        case AFC_ECHOLIST:          ReadEcholist(buf);                    break;
+        case AFC_AREADESC:          SetAreaDesc(buf, buf2);               break;
+        case AFC_ADEPTXBBSPATH:     CfgAdeptxbbspath(buf, make_bool(i->n)); break;
+        case AFC_EZYCOMMSGBASE:     CfgEzycommsgbase(buf, make_bool(i->n)); break;
+        case AFC_EZYCOMUSERBASE:    CfgEzycomuserbase(buf, make_bool(i->n)); break;
+        case AFC_GOLDBASEPATH:      CfgGoldbasepath(buf, make_bool(i->n)); break;
+        case AFC_HUDSONPATH:        CfgHudsonpath(buf, make_bool(i->n));  break;
+        case AFC_JAMPATH:           CfgJampath(buf, make_bool(i->n));     break;
+        case AFC_PCBOARDPATH:       CfgPcboardpath(buf, make_bool(i->n)); break;
+        case AFC_SQUISHUSERPATH:    CfgSquishuserpath(buf, make_bool(i->n)); break;
+        case AFC_FIDOLASTREAD:      CfgFidolastread(buf);                 break;
+        case AFC_SETENV:            SetEnviron(i->s1.c_str());            break;
+        }
+    }
+
+    Sync(*entry, echos, descs, entry->echos.size(), entry->descs.size());
+
+    AFILE->ra2usersbbs = entry->ra2usersbbs;
+    AFILE->squishuserno = entry->squishuserno;
+
+    entry->used = true;
+    return true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Start recording the callbacks of an areafile reader
+
+void GAreafileCache::Begin(const std::string& key)
+{
+
+    std::vector<Entry>::iterator entry;
+    for(entry = entries.begin(); entry != entries.end(); entry++)
+    {
+        if(entry->key == key)
+        {
+            entries.erase(entry);
+            break;
+        }
+    }
+
+    entries.push_back(Entry());
+    entries.back().key = key;
+    entries.back().used = false;
+    current = entries.size() - 1;
+    nested = false;
+
+    echostart = AFILE->echolist.Echos();
+    descstart = AFILE->echolist.Descs();
+
+    journal.clear();
+    gfile_journal = &journal;
+}
+
+
+//  ------------------------------------------------------------------
+//  Stop recording and stamp all files the reader looked at
+
+void GAreafileCache::End()
+{
+
+    gfile_journal = NULL;
+
+    if(current == -1)
+        return;
+
+    Entry& entry = entries[current];
+    current = -1;
+
+    uint n;
+    char* echoid;
+    char* path;
+    char* desc;
+    for(n = echostart; n < (uint)AFILE->echolist.Echos(); n++)
+    {
+        EchoList echo;
+        AFILE->echolist.GetEcho(n, &echoid, &path, &desc);
+        strxcpy(echo.echoid, echoid, sizeof(echo.echoid));
+        strxcpy(echo.path, path, sizeof(echo.path));
+        strxcpy(echo.desc, desc, sizeof(echo.desc));
+        entry.echos.push_back(echo);
+    }
+    for(n = descstart; n < (uint)AFILE->echolist.Descs(); n++)
+    {
+        DescList dl;
+        AFILE->echolist.GetDesc(n, &echoid, &desc);
+        strxcpy(dl.echoid, echoid, sizeof(dl.echoid));
+        strxcpy(dl.desc, desc, sizeof(dl.desc));
+        entry.descs.push_back(dl);
+    }
+
+    entry.ra2usersbbs = AFILE->ra2usersbbs;
+    entry.squishuserno = AFILE->squishuserno;
+
+    std::sort(journal.begin(), journal.end());
+    journal.erase(std::unique(journal.begin(), journal.end()), journal.end());
+
+    std::vector<std::string>::iterator i;
+    for(i = journal.begin(); i != journal.end(); i++)
+    {
+        Stamp stamp;
+        struct stat st;
+
+        stamp.path = *i;
+        if(stat(i->c_str(), &st) == 0)
+        {
+            stamp.size = (long)st.st_size;
+            stamp.mtime = (dword)st.st_mtime;
+        }
+        else
+        {
+            stamp.size = -1;
+            stamp.mtime = 0;
+        }
+        entry.stamps.push_back(stamp);
+    }
+    journal.clear();
+
+    entry.used = true;
+    dirty = true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Note a callback made by the areafile reader
+
+void GAreafileCache::Record(int code, const char* s1, const char* s2, int n)
+{
+
+    Event event;
+    event.code = code;
+    event.n = n;
+    event.s1 = s1 ? s1 : "";
+    event.s2 = s2 ? s2 : "";
+    event.echos = AFILE->echolist.Echos() - echostart;
+    event.descs = AFILE->echolist.Descs() - descstart;
+    entries[current].events.push_back(event);
+}
+
+
+//  ------------------------------------------------------------------
+
+void GAreafileCache::Record(const AreaCfg& aa)
+{
+
+    Entry& entry = entries[current];
+    Record(AFC_AREA, NULL, NULL, entry.areas.size());
+    entry.areas.push_back(aa);
+}
+
+
 //  ------------------------------------------------------------------
 //  Get area definition
 
@@ -875,6 +1585,7 @@ void AreaList::GetAreaDef(char* val)
 void ReadEcholist(char* val)
 {
 
+    GAreafileEvent event(AFC_ECHOLIST, val);
     AL.ReadEcholist(val);
 }
 
@@ -987,17 +1698,11 @@ void AreaList::ReadEcholist(char* val)
                                 desc = NULL;
                         }
 
-                        area_iterator ap = idx.begin();
-                        area_iterator end = idx.end();
-
-                        for (; ap != end; ap++)
+                        Area* ap = EchoIndexFind(key);
+                        if (ap)
                         {
-                            if (strieql(key, (*ap)->echoid()))
-                            {
-                                (*ap)->set_groupid(g_toupper(*grp));
-                                if (desc) (*ap)->set_desc(desc);
-                                break;
-                            }
+                            ap->set_groupid(g_toupper(*grp));
+                            if (desc) ap->set_desc(desc);
                         }
                     }
                     else
@@ -1008,17 +1713,9 @@ void AreaList::ReadEcholist(char* val)
                         else
                             desc = val;
 
-                        area_iterator ap = idx.begin();
-                        area_iterator end = idx.end();
-
-                        for (; ap != end; ap++)
-                        {
-                            if (strieql(key, (*ap)->echoid()))
-                            {
-                                (*ap)->set_desc(desc);
-                                break;
-                            }
-                        }
+                        Area* ap = EchoIndexFind(key);
+                        if (ap)
+                            ap->set_desc(desc);
                     }
                 }
             }
@@ -1121,6 +1818,7 @@ Area::Area(gmo_area* a)
     adat = NULL;
     bookmark = 0;
     marks = 0;
+    goldlast = 0;
     unread = 0;
     isvalidchg = false;
     isunreadchg = false;
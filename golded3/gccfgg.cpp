@@ -61,6 +61,9 @@ bool ReadGoldedCfg()
     if(ReadCfg(golded_cfg))
     {
 
+        // Keep the areafile snapshot for the next start
+        AFC.Save();
+
         // Unallocate echolist
         AFILE->echolist.FreeAll();
 
@@ -108,6 +108,7 @@ tglobalbool globalbool[gswitches_last] =
 
 void CfgJAMSMAPIHighwater(bool value)
 {
+    GAreafileEvent event(AFC_JAMSMAPIHIGHWATER, NULL, NULL, value);
     CFG->switches.handle(CRC_JAMSMAPIHIGHWATER, value ? "YES" : "NO");
 }
 
@@ -899,6 +900,9 @@ SwitchN:
     case CRC_NETNAME          :
         CfgNetname          ();
         break;
+    case CRC_NODEDIFF         :
+        CfgNodediff         ();
+        break;
     case CRC_NODELIST         :
         CfgNodelist         ();
         break;
@@ -41,6 +41,7 @@ void CfgAddress()
 }
 void CfgAddress(char* v)
 {
+    GAreafileEvent event(AFC_ADDRESS, v);
     if (not strblank(v))
     {
         if (veryverbose)
@@ -162,6 +163,7 @@ void CfgAddressmacro()
 void CfgAdeptxbbspath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_ADEPTXBBSPATH, path, NULL, force);
     if (force or strblank(CFG->adeptxbbspath))
         MapPath(PathCopy(CFG->adeptxbbspath, path));
 }
@@ -342,6 +342,7 @@ void CfgColorname()
     strxcpy(cn.name, val, sizeof(cn.name));
 
     CFG->colorname.push_back(std::pair<Node, vattr>(cn, color));
+    ColorNameReset();
 }
 
 //  ------------------------------------------------------------------
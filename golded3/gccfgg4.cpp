@@ -157,6 +157,7 @@ void CfgExternutil()
 void CfgEzycommsgbase(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_EZYCOMMSGBASE, path, NULL, force);
     if(force or strblank(CFG->ezycom.msgbasepath))
         MapPath(PathCopy(CFG->ezycom.msgbasepath, path));
 }
@@ -172,6 +173,7 @@ void CfgEzycommsgbase()
 void CfgEzycomuserbase(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_EZYCOMUSERBASE, path, NULL, force);
     if(force or strblank(CFG->ezycom.userbasepath))
         MapPath(PathCopy(CFG->ezycom.userbasepath, path));
 }
@@ -195,6 +197,7 @@ void CfgEzycomuserno()
 void CfgFidolastread(const char *path)
 {
 
+    GAreafileEvent event(AFC_FIDOLASTREAD, path);
     MapPath(strxcpy(CFG->fidolastread, path, sizeof(Path)));
 }
 
@@ -331,6 +334,7 @@ void CfgGermankeyboard()
 void CfgGoldbasepath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_GOLDBASEPATH, path, NULL, force);
     if(force or strblank(CFG->goldbasepath))
         MapPath(PathCopy(CFG->goldbasepath, path));
 }
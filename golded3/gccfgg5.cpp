@@ -47,6 +47,7 @@ void CfgHighlighturls()
 void CfgHudsonpath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_HUDSONPATH, path, NULL, force);
     if(force or strblank(CFG->hudsonpath))
         MapPath(PathCopy(CFG->hudsonpath, path));
 }
@@ -296,6 +297,7 @@ void CfgInvalidate()
 void CfgJampath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_JAMPATH, path, NULL, force);
     if(force or strblank(CFG->jampath))
         MapPath(PathCopy(CFG->jampath, path));
 }
@@ -107,6 +107,14 @@ void CfgNetname()
 
 //  ------------------------------------------------------------------
 
+void CfgNodediff()
+{
+
+    // Only used by GoldNODE
+}
+
+//  ------------------------------------------------------------------
+
 void CfgNodelist()
 {
 
@@ -257,6 +265,7 @@ void CfgOrganization()
 
 void CfgOrigin(const char* v)
 {
+    GAreafileEvent event(AFC_ORIGIN, v);
     char buf[256];
     val = strxcpy(buf, v, sizeof(buf));
     CfgOrigin();
@@ -306,6 +315,7 @@ void CfgPathreportfile()
 void CfgPcboardpath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_PCBOARDPATH, path, NULL, force);
     if(force or strblank(CFG->pcboardpath))
         MapPath(PathCopy(CFG->pcboardpath, path));
 }
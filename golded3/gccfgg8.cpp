@@ -46,6 +46,7 @@ void CfgSquishuserno()
 void CfgSquishuserpath(const char *path, bool force)
 {
 
+    GAreafileEvent event(AFC_SQUISHUSERPATH, path, NULL, force);
     if(force or strblank(CFG->squishuserpath))
     {
 
@@ -465,6 +466,7 @@ void CfgUserlistfile()
 
 void CfgUsername(char* v)
 {
+    GAreafileEvent event(AFC_USERNAME, v);
     val = v;
     CfgUsername();
 }
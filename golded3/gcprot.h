@@ -258,6 +258,7 @@
     void CfgNewsgroups       ();
     void CfgNickname         ();
     void CfgNetname          ();
+    void CfgNodediff         ();
     void CfgNodelist         ();
     void CfgNodelistwarn     ();
     void CfgNodepath         ();
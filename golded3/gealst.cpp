@@ -31,6 +31,7 @@
     #pragma warning(disable: 4786)
 #endif
 #include <algorithm>
+#include <map>
 #include <limits.h>
 #include <golded.h>
 
@@ -66,28 +67,77 @@ int AreaTypeOrder[17] =
 
 
 //  ------------------------------------------------------------------
-//  Areagroups compare
+//  Arealist sort data, computed once per sort instead of per compare
 
-int compare_groups(int _ga, int _gb)
+struct AreaSortOp
 {
-    int ga = _ga ? _ga : INT_MAX;
-    int gb = _gb ? _gb : INT_MAX;
+    char key;        // Sort spec letter
+    bool rev;        // Reverse order for this key
+    bool sepfirst;   // Separators go before their areas
+};
+
+struct AreaSortKey
+{
+    Area* area;
+    int   grouppos;  // Position in AREALISTGROUPORDER, INT_MAX if not listed
+    int   group;     // Group id, INT_MAX if no group
+    int   typeorder; // AREATYPEORDER rank
+    bool  maybe;     // Echoid contains area_maybe
+};
 
-    const char *gap = NULL;
-    const char *gbp = NULL;
 
-    const char *g;
+//  ------------------------------------------------------------------
+//  Compile sort specs into a list of operations
+
+static void AreaSortCompile(const char* spec, std::vector<AreaSortOp>& ops)
+{
+    AreaSortOp op;
+    op.rev = false;
+    op.sepfirst = false;
 
-    for(g = CFG->arealistgrouporder; *g != NUL;)
+    for(const char* ptr = spec; *ptr; ptr++)
     {
+        switch(*ptr)
+        {
+        case '-':
+            op.rev = true;
+            break;
+        case '+':
+            op.rev = false;
+            break;
+        case 'A': case 'a':
+        case 'G': case 'g':
+        case 'T': case 't':
+            op.sepfirst = true;
+            // Fall through
+        case 'B': case 'b':
+        case 'D': case 'd':
+        case 'E': case 'e':
+        case 'F': case 'f':
+        case 'M': case 'm':
+        case 'O': case 'o':
+        case 'P': case 'p':
+        case 'U': case 'u':
+        case 'X': case 'x':
+        case 'Y': case 'y':
+        case 'Z': case 'z':
+        case 'S': case 's':
+            op.key = *ptr;
+            ops.push_back(op);
+            break;
+        }
+    }
+}
 
-        int gr = getgroup(g);
 
-        if(gr == ga)
-            gap = g;
+//  ------------------------------------------------------------------
+//  Map each group to its last position in AREALISTGROUPORDER
 
-        if(gr == gb)
-            gbp = g;
+static void AreaSortGroupOrder(std::map<int, int>& order)
+{
+    for(const char *g = CFG->arealistgrouporder; *g != NUL;)
+    {
+        order[getgroup(g)] = int(g - CFG->arealistgrouporder);
 
         if(*g == '#')
         {
@@ -100,58 +150,54 @@ int compare_groups(int _ga, int _gb)
         else
             g++;
     }
-
-    if(gap == NULL)
-    {
-        if(gbp != NULL)
-            return 1;
-        else
-            return compare_two(ga, gb);
-    }
-    else
-    {
-        if(gbp == NULL)
-            return -1;
-        else
-            return compare_two(gap, gbp);
-    }
 }
 
 
 //  ------------------------------------------------------------------
 //  Arealist compare
 
-extern "C" int AreaListCmp(const Area** __a, const Area** __b)
+class AreaSortCmp
 {
+    const std::vector<AreaSortOp>& ops;
 
-    const Area* a = *__a;
-    const Area* b = *__b;
-    const Area* A = a;
-    const Area* B = b;
-    int cmp = 0;
+public:
 
-    bool sepfirst = false;
+    AreaSortCmp(const std::vector<AreaSortOp>& o) : ops(o) {}
 
-    bool rev = false;
-    char* ptr = AL.sortspec;
+    int compare(const AreaSortKey& ka, const AreaSortKey& kb) const;
 
-    while(*ptr)
+    bool operator()(const AreaSortKey& ka, const AreaSortKey& kb) const
     {
-        switch(*ptr)
+        return compare(ka, kb) < 0;
+    }
+};
+
+
+int AreaSortCmp::compare(const AreaSortKey& ka, const AreaSortKey& kb) const
+{
+
+    const AreaSortKey* KA = &ka;
+    const AreaSortKey* KB = &kb;
+    const Area* A = ka.area;
+    const Area* B = kb.area;
+    int cmp = 0;
+
+    for(std::vector<AreaSortOp>::const_iterator op = ops.begin(); op != ops.end(); op++)
+    {
+        bool rev = op->rev;
+        bool sepfirst = op->sepfirst;
+
+        if(rev)
+            KA = &kb, KB = &ka;
+        else
+            KA = &ka, KB = &kb;
+        A = KA->area;
+        B = KB->area;
+
+        switch(op->key)
         {
-        case '-':
-            rev = true;
-            A = b;
-            B = a;
-            break;
-        case '+':
-            rev = false;
-            A = a;
-            B = b;
-            break;
         case 'A':
         case 'a':
-            sepfirst = true;
             if((cmp = A->aka().compare(B->aka())) != 0)
                 return cmp;
             break;
@@ -184,19 +230,14 @@ extern "C" int AreaListCmp(const Area** __a, const Area** __b)
             break;
         case 'F':
         case 'f':
-            if(*area_maybe)
-            {
-                bool amay = make_bool(striinc(area_maybe, A->echoid()));
-                bool bmay = make_bool(striinc(area_maybe, B->echoid()));
-
-                if((cmp = compare_two(bmay, amay)) != 0)
-                    return cmp;
-            }
+            if((cmp = compare_two(KB->maybe, KA->maybe)) != 0)
+                return cmp;
             break;
         case 'G':
         case 'g':
-            sepfirst = true;
-            if((cmp = compare_groups(A->groupid(), B->groupid())) != 0)
+            if((cmp = compare_two(KA->grouppos, KB->grouppos)) != 0)
+                return cmp;
+            if((cmp = compare_two(KA->group, KB->group)) != 0)
                 return cmp;
             break;
         case 'M':
@@ -263,8 +304,7 @@ extern "C" int AreaListCmp(const Area** __a, const Area** __b)
             break;
         case 'T':
         case 't':
-            sepfirst = true;
-            if((cmp = compare_two(CFG->areatypeorder[A->type()&0xFF], CFG->areatypeorder[B->type()&0xFF])) != 0)
+            if((cmp = compare_two(KA->typeorder, KB->typeorder)) != 0)
                 return cmp;
             break;
         case 'U':
@@ -356,7 +396,6 @@ extern "C" int AreaListCmp(const Area** __a, const Area** __b)
                 return cmp;
             break;
         }
-        ptr++;
     }
 
     if(cmp == 0)
@@ -367,11 +406,6 @@ extern "C" int AreaListCmp(const Area** __a, const Area** __b)
     return cmp;
 }
 
-static bool AreaListCmp2(const Area* a, const Area* b)
-{
-
-    return AreaListCmp(&a, &b) < 0;
-}
 
 //  ------------------------------------------------------------------
 //  Arealist sort areas
@@ -385,9 +419,35 @@ void AreaList::Sort(const char* specs, int first, int last)
         strcpy(sortspec, CFG->arealistsort);
     if(last == -1)
         last = idx.size();
-    if(*sortspec)
+    if(*sortspec and (last > first))
     {
-        std::sort(idx.begin()+first, idx.begin()+last, AreaListCmp2);
+        EchoIndexReset();
+
+        std::vector<AreaSortOp> ops;
+        AreaSortCompile(sortspec, ops);
+
+        std::map<int, int> grouporder;
+        AreaSortGroupOrder(grouporder);
+
+        std::vector<AreaSortKey> keys(last - first);
+        for(int n = first; n < last; n++)
+        {
+            AreaSortKey& key = keys[n - first];
+            Area* a = idx[n];
+            int g = a->groupid() ? a->groupid() : INT_MAX;
+            std::map<int, int>::const_iterator it = grouporder.find(g);
+
+            key.area = a;
+            key.group = g;
+            key.grouppos = (it != grouporder.end()) ? it->second : INT_MAX;
+            key.typeorder = CFG->areatypeorder[a->type()&0xFF];
+            key.maybe = *area_maybe ? make_bool(striinc(area_maybe, a->echoid())) : false;
+        }
+
+        std::sort(keys.begin(), keys.end(), AreaSortCmp(ops));
+
+        for(int n = first; n < last; n++)
+            idx[n] = keys[n - first].area;
     }
 }
 
@@ -536,6 +536,14 @@ void CmfMsgs(GMsg* msg, bool torecycle)
     AA->Open();
     AA->RandomizeData();
 
+    // Hold the destination lock for the whole copy/move, so the
+    // msgbase index and header info are written once at the end
+    // instead of after every saved message.  Not for forwards, which
+    // go through the editor.
+    bool lockdest = (cmf != MODE_FORWARD);
+    if(lockdest)
+        AA->Lock();
+
     // Re-activeate original area and lock that too
     AL.SetActiveAreaId(OrigArea);
     AA->Lock();
@@ -731,6 +739,8 @@ void CmfMsgs(GMsg* msg, bool torecycle)
 
     // close destination area
     AL.SetActiveAreaId(destarea);
+    if(lockdest)
+        AA->Unlock();
     AA->UpdateAreadata();
     AA->Close();
 
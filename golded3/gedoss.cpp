@@ -113,6 +113,7 @@ void Cleanup(void)
         CFG->aka.clear();
         CFG->akamatch.clear();
         CFG->colorname.clear();
+        ColorNameReset();
         CFG->event.clear();
         CFG->externutil.clear();
         CFG->filealias.clear();
@@ -47,6 +47,122 @@ Path Edit__exportfilename = {""};
 UndoItem** UndoItem::last_item;
 
 
+//  ------------------------------------------------------------------
+//  Undo record pools. Records are carved from blocks and recycled
+//  through a free list, the blocks are released when the last record
+//  is deleted. Undo items and short undo texts are pushed for nearly
+//  every keystroke, so neither goes through malloc() each time.
+
+#define UNDO_POOLBLOCK 256
+#define UNDO_TEXTSLOT  64
+
+class UndoPool
+{
+
+    size_t slotsize;
+    char*  blocks;      // Block chain, linked by first word
+    char*  freelist;    // Free slots, linked by first word
+    long   items;       // Slots in use
+
+public:
+
+    UndoPool(size_t size) : slotsize(size), blocks(NULL), freelist(NULL), items(0) { }
+
+    void* alloc();
+    void  release(void* ptr);
+};
+
+void* UndoPool::alloc()
+{
+
+    if(freelist == NULL)
+    {
+        char* block = (char*)throw_malloc(slotsize * (UNDO_POOLBLOCK + 1));
+        *(char**)block = blocks;
+        blocks = block;
+        for(int n = UNDO_POOLBLOCK; n; n--)
+        {
+            char* slot = block + n * slotsize;
+            *(char**)slot = freelist;
+            freelist = slot;
+        }
+    }
+
+    char* slot = freelist;
+    freelist = *(char**)slot;
+    items++;
+    return slot;
+}
+
+void UndoPool::release(void* ptr)
+{
+
+    *(char**)ptr = freelist;
+    freelist = (char*)ptr;
+
+    if(--items == 0)
+    {
+        while(blocks)
+        {
+            char* block = blocks;
+            blocks = *(char**)block;
+            throw_free(block);
+        }
+        freelist = NULL;
+    }
+}
+
+static UndoPool undo_itempool(sizeof(UndoItem));
+static UndoPool undo_textpool(UNDO_TEXTSLOT);
+
+void* UndoItem::operator new(size_t size)
+{
+
+    NW(size);
+    return undo_itempool.alloc();
+}
+
+void UndoItem::operator delete(void* ptr)
+{
+
+    if(ptr)
+        undo_itempool.release(ptr);
+}
+
+
+//  ------------------------------------------------------------------
+//  Text records are preceded by their allocated size, so delete knows
+//  whether they came from the pool
+
+void* text_item::operator new(size_t size, uint text_len)
+{
+
+    size_t need = sizeof(size_t) + size + text_len;
+    char* ptr = (char*)((need <= UNDO_TEXTSLOT) ? undo_textpool.alloc() : throw_malloc(need));
+    *(size_t*)ptr = need;
+    return ptr + sizeof(size_t);
+}
+
+void text_item::operator delete(void* ptr)
+{
+
+    if(ptr == NULL)
+        return;
+
+    char* block = (char*)ptr - sizeof(size_t);
+    if(*(size_t*)block <= UNDO_TEXTSLOT)
+        undo_textpool.release(block);
+    else
+        throw_free(block);
+}
+
+void text_item::operator delete(void* ptr, uint)
+{
+
+    operator delete(ptr);
+}
+
+
 //  ------------------------------------------------------------------
 
 #ifndef NDEBUG
@@ -180,6 +296,8 @@ void IEclass::cursoron()
 void IEclass::scrollup(int __scol, int __srow, int __ecol, int __erow, int __lines)
 {
 
+    if(holddisplay)
+        return;
     editwin.scroll_box_up(__srow, __scol, __erow, __ecol, __lines);
 }
 
@@ -190,6 +308,8 @@ void IEclass::scrollup(int __scol, int __srow, int __ecol, int __erow, int __lin
 void IEclass::scrolldown(int __scol, int __srow, int __ecol, int __erow, int __lines)
 {
 
+    if(holddisplay)
+        return;
     editwin.scroll_box_down(__srow, __scol, __erow, __ecol, __lines);
 }
 
@@ -668,6 +788,12 @@ void IEclass::displine(Line* __line, uint __row)
     _test_halt(__line == NULL);
     _test_haltab(__row > maxrow, __row, maxrow);
 
+    if(holddisplay)
+    {
+        GFTRK(0);
+        return;
+    }
+
     // Display line
     setcolor(__line);
 #if defined(GCFG_SPELL_INCLUDED)
@@ -711,6 +837,12 @@ void IEclass::refresh(Line* __currline, uint __row)
 
     _test_halt(__currline == NULL);
 
+    if(holddisplay)
+    {
+        GFTRK(0);
+        return;
+    }
+
     cursoroff();
 
     // Display as many lines as we can
@@ -955,6 +1087,78 @@ void IEclass::GoRight()
 }
 
 
+//  ------------------------------------------------------------------
+//  Find where a line longer than the wrap margin must be broken
+
+int IEclass::wrapposition(const std::string& __txt, uint __wrapmargin, uint __quotelen)
+{
+
+    // wrapmargin = 40
+    //                   1111111111222222222233333333334444444444
+    //         01234567890123456789012345678901234567890123456789
+    //         --------------------------------------------------
+    //                                                v- wrapptr
+    // Case 1: this is another test with a bit of text to wrap.
+    // Case 2: this is a test with a line that need wrapping.
+    // Case 3: thisxisxaxtestxwithxaxlinexthatxneedxwrapping.
+    // Case 4: >thisxisxaxtestxwithxaxlinexthatxneedxwrapping.
+
+    // Point to the last char inside the margin
+    int _wrappos = __wrapmargin - 1;
+
+    // Locate the word to be wrapped
+
+    // Did we find a space?
+    if(__txt[_wrappos] == ' ')
+    {
+
+        // Case 1: A space was found as the last char inside the margin
+        //
+        // Now we must locate the first word outside the margin.
+        // NOTE: Leading spaces to this word will be nulled out!
+
+        // Begin at the first char outside the margin
+        if(_wrappos <= maxcol)
+            _wrappos++;
+    }
+    else
+    {
+
+        // Case 2: A non-space was found as the last char inside the margin
+        //
+        // Now we must locate the beginning of the word we found.
+
+        // Keep copy of original pointer
+        int _atmargin = _wrappos;
+
+        // Search backwards until a space or the beginning of the line is found
+        while((_wrappos > __quotelen) and (__txt[_wrappos-1] != ' '))
+            _wrappos--;
+
+        // Check if we hit leading spaces
+        int _spacepos = _wrappos;
+        while(_spacepos > 0)
+        {
+            _spacepos--;
+            if(__txt[_spacepos] != ' ')
+                break;
+        }
+
+        // Did we search all the way back to the beginning of the line?
+        if((_wrappos == __quotelen) or (__txt[_spacepos] == ' '))
+        {
+
+            // Case 3: There are no spaces within the margin or we hit leading spaces
+
+            // We have to break it up at the margin
+            _wrappos = _atmargin;
+        }
+    }
+
+    return _wrappos;
+}
+
+
 //  ------------------------------------------------------------------
 
 Line* IEclass::wrapit(Line** __currline, uint* __curr_col, uint* __curr_row, bool __display)
@@ -1003,67 +1207,8 @@ Line* IEclass::wrapit(Line** __currline, uint* __curr_col, uint* __curr_row, boo
                 GetQuotestr(_thisline->txt.c_str(), _quotebuf, &_quotelen);
             }
 
-            // wrapmargin = 40
-            //                   1111111111222222222233333333334444444444
-            //         01234567890123456789012345678901234567890123456789
-            //         --------------------------------------------------
-            //                                                v- wrapptr
-            // Case 1: this is another test with a bit of text to wrap.
-            // Case 2: this is a test with a line that need wrapping.
-            // Case 3: thisxisxaxtestxwithxaxlinexthatxneedxwrapping.
-            // Case 4: >thisxisxaxtestxwithxaxlinexthatxneedxwrapping.
-
-            // Point to the last char inside the margin
-            int _wrappos = _wrapmargin - 1;
-
             // Locate the word to be wrapped
-
-            // Did we find a space?
-            if(_thisline->txt[_wrappos] == ' ')
-            {
-
-                // Case 1: A space was found as the last char inside the margin
-                //
-                // Now we must locate the first word outside the margin.
-                // NOTE: Leading spaces to this word will be nulled out!
-
-                // Begin at the first char outside the margin
-                if(_wrappos <= maxcol)
-                    _wrappos++;
-            }
-            else
-            {
-
-                // Case 2: A non-space was found as the last char inside the margin
-                //
-                // Now we must locate the beginning of the word we found.
-
-                // Keep copy of original pointer
-                int _atmargin = _wrappos;
-
-                // Search backwards until a space or the beginning of the line is found
-                while((_wrappos > _quotelen) and (_thisline->txt[_wrappos-1] != ' '))
-                    _wrappos--;
-
-                // Check if we hit leading spaces
-                int _spacepos = _wrappos;
-                while(_spacepos > 0)
-                {
-                    _spacepos--;
-                    if(_thisline->txt[_spacepos] != ' ')
-                        break;
-                }
-
-                // Did we search all the way back to the beginning of the line?
-                if((_wrappos == _quotelen) or (_thisline->txt[_spacepos] == ' '))
-                {
-
-                    // Case 3: There are no spaces within the margin or we hit leading spaces
-
-                    // We have to break it up at the margin
-                    _wrappos = _atmargin;
-                }
-            }
+            int _wrappos = wrapposition(_thisline->txt, _wrapmargin, _quotelen);
 
             // The wrappos now points to the location to be wrapped or NUL
 
@@ -1335,6 +1480,117 @@ Line* IEclass::wrapins(Line** __currline, uint* __curr_col, uint* __curr_row, bo
 }
 
 
+//  ------------------------------------------------------------------
+//  Insert a paragraph below the last line and wrap it. Long paragraphs
+//  give the same lines as inserting them whole and calling wrapit(), but
+//  only a window of the text is copied to each line, instead of moving
+//  the whole remainder down one line per wrap. Undo just gets the new
+//  lines, which is all it needs to take the paragraph out again.
+
+#define EDIT_WRAPWINDOW 1024
+
+Line* IEclass::insertwrapped(Line* __line, const char* __text)
+{
+
+    GFTRK("Editinsertwrapped");
+
+    _test_halt(__line->next != NULL);
+
+    uint  _quotelen = 0;
+    char  _quotebuf[MAXQUOTELEN];
+    *_quotebuf = NUL;
+
+    // Start of the next line not copied yet, and the text following it
+    std::string _pending;
+    const char* _rest = __text;
+    uint _restlen = strlen(__text);
+
+    // The window must hold a full line, and only a trailing linefeed
+    // is allowed, else the whole text goes to wrapit()
+    uint _window = MaxV(uint(EDIT_WRAPWINDOW), 4*uint(MaxV(margintext, marginquotes)));
+    const char* _lf = strchr(__text, '\n');
+    if((_restlen <= _window) or (_lf and _lf[1]))
+    {
+        Line* _newline = insertlinebelow(__line, __text);
+        setlinetype(_newline);
+        uint _wrapmargin = (_newline->type & GLINE_QUOT) ? marginquotes : margintext;
+        if(_newline->txt.length() >= _wrapmargin)
+        {
+            uint _tmpcol = 0;
+            uint _tmprow = 0;
+            _newline = wrapins(&_newline, &_tmpcol, &_tmprow, false);
+        }
+        GFTRK(0);
+        return _newline;
+    }
+
+    bool _hardlast = false;
+    while(_pending.length() + _restlen > _window)
+    {
+
+        // Fill the window and add it as a line
+        uint _fill = (_pending.length() < _window) ? MinV(_restlen, uint(_window - _pending.length())) : 0;
+        _pending.append(_rest, _fill);
+        _rest += _fill;
+        _restlen -= _fill;
+        Line* _thisline = insertlinebelow(__line, _pending.c_str(), BATCH_MODE);
+        setlinetype(_thisline);
+        uint _wrapmargin = (_thisline->type & GLINE_QUOT) ? marginquotes : margintext;
+
+        _quotelen = 0;
+        if(_thisline->type & GLINE_QUOT)
+            GetQuotestr(_thisline->txt.c_str(), _quotebuf, &_quotelen);
+
+        // The window is longer than any margin, so it always wraps
+        int _wrappos = wrapposition(_thisline->txt, _wrapmargin, _quotelen);
+        _pending = _quotebuf;
+        _pending += _thisline->txt.c_str() + _wrappos;
+        _thisline->txt.erase(_wrappos);
+
+        // Quoted lines are trimmed and terminated as in wrapit()
+        if(_quotelen)
+        {
+            int _trimpos = _wrappos - 1;
+            if(isspace(_thisline->txt[_trimpos]))
+            {
+                while(_trimpos > 0 and isspace(_thisline->txt[_trimpos-1]))
+                    _trimpos--;
+                if(_trimpos < _quotelen)
+                    _trimpos++;
+                _thisline->txt.erase(_trimpos);
+            }
+            _thisline->txt += "\n";
+        }
+        setlinetype(_thisline);
+
+        _hardlast = _thisline->txt.find('\n') != _thisline->txt.npos;
+        if(not _hardlast and (_thisline->type & GLINE_QUOT))
+        {
+            _thisline->txt += '\n';
+            _hardlast = true;
+        }
+
+        __line = _thisline;
+    }
+
+    // Leave the short tail to wrapit(), which skips it in the same case
+    _pending.append(_rest, _restlen);
+    Line* _lastline = insertlinebelow(__line, _pending.c_str(), BATCH_MODE);
+    setlinetype(_lastline);
+    uint _wrapmargin = (_lastline->type & GLINE_QUOT) ? marginquotes : margintext;
+    if(not _hardlast or (_lastline->txt.length() > _wrapmargin))
+    {
+        uint _tmpcol = 0;
+        uint _tmprow = 0;
+        _lastline = wrapins(&_lastline, &_tmpcol, &_tmprow, false);
+    }
+
+    GFTRK(0);
+
+    return _lastline;
+}
+
+
 //  ------------------------------------------------------------------
 
 void IEclass::insertchar(char __ch)
@@ -2444,6 +2700,10 @@ void IEclass::Reflow()
         currline->txt.erase(_qlen1, ptr-_qlenptr);
     }
 
+    // Joining the lines one by one rewraps and repaints the rest of the
+    // paragraph each time, so the screen is only drawn when it is done
+    holddisplay = true;
+
     // Perform the reflow
     while(reflowok(_qstr1))
     {
@@ -2472,8 +2732,10 @@ void IEclass::Reflow()
         }
     }
 
+    holddisplay = false;
+    refresh(findtopline(), minrow);
+
     // Go to the next line
-    displine(currline,row);
     GoDown();
     col = mincol;
 
@@ -137,18 +137,11 @@ public:
     __extension__ char text[0]; // Text string itself
 
     text_item(uint __col, uint __len) : col(__col), len(__len) { }
-    void* operator new(size_t size, uint text_len = 0)
-    {
-        return malloc(sizeof(text_item) + size + text_len);
-    }
-    void operator delete(void* ptr)
-    {
-        free(ptr);
-    }
-    void operator delete(void* ptr, uint)
-    {
-        free(ptr);
-    }
+
+    // Short records are taken from a pool, like UndoItem
+    void* operator new(size_t size, uint text_len = 0);
+    void operator delete(void* ptr);
+    void operator delete(void* ptr, uint);
 };
 
 //  ----------------------------------------------------------------
@@ -197,6 +190,10 @@ public:
     {
         *last_item = this->prev;
     }
+
+    // Taken from a pool, since one is pushed for nearly every keystroke
+    void* operator new(size_t size);
+    void operator delete(void* ptr);
 };
 
 //  ----------------------------------------------------------------
@@ -303,6 +300,7 @@ protected:
     char*  unfinished;
     int  blockcol;
     int  selecting;
+    bool holddisplay;      // Skip screen updates until the next refresh
 
     //  ----------------------------------------------------------------
     //  Speller (DLL)
@@ -340,6 +338,7 @@ protected:
     void  imptxt          (char* __filename, bool imptxt = false);
     void  insertchar      (char __ch);
     Line* insertlinebelow (Line* __currline, const char* __text = NULL, long __batch_mode = 0);
+    Line* insertwrapped   (Line* __line, const char* __text);
     int   isempty         (Line* __line=NULL);
     void  killkillbuf     ();
     void  killpastebuf    ();
@@ -354,6 +353,7 @@ protected:
     void  statusline      ();
     void  windowclose     ();
     void  windowopen      ();
+    int   wrapposition    (const std::string& __txt, uint __wrapmargin, uint __quotelen);
     Line* wrapit          (Line** __currline, uint* __curr_col, uint* __curr_row, bool __display=true);
     Line* wrapdel         (Line** __currline, uint* __curr_col, uint* __curr_row, bool __display=true);
     Line* wrapins         (Line** __currline, uint* __curr_col, uint* __curr_row, bool __display=true);
@@ -73,6 +73,7 @@ IEclass::IEclass(int __scol, int __ecol, int __srow, int __erow, int __border)
     unfinished   = "+$!$+ GoldED Internal Editor: Unfinished Message!";
     blockcol     = -1;
     selecting    = NO;
+    holddisplay  = false;
 
     throw_new(Undo = new UndoStack(this));
     windowopen();
@@ -1251,22 +1252,8 @@ void IEclass::editimport(Line* __line, char* __filename, bool imptxt)
                         }
                     }
 
-                    // Copy the paragraph to the new line and retype it
-                    Line* _newline = __line = insertlinebelow(__line, tmp.c_str());
-                    setlinetype(_newline);
-
-                    // If the paragraph is longer than one line
-                    uint _wrapmargin = (_newline->type & GLINE_QUOT) ? marginquotes : margintext;
-                    if(_newline->txt.length() >= _wrapmargin)
-                    {
-
-                        // Wrap it
-                        uint _tmpcol = 0;
-                        uint _tmprow = 0;
-                        _newline = wrapins(&_newline, &_tmpcol, &_tmprow, false);
-                    }
-
-                    __line = _newline;
+                    // Copy the paragraph to new lines and wrap it
+                    __line = insertwrapped(__line, tmp.c_str());
                 }
 
                 while(__line->next)
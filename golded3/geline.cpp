@@ -2564,26 +2564,28 @@ void MakeLineIndex(GMsg* msg, int margin, bool getvalue, bool header_recode)
 
                     GetQuotestr(bad_ptr = ptr, bad_qbuf, &bad_qlen);
 
+                    // Join the following lines with the same quotestring,
+                    // compacting as we go and closing the gap once at the end
+                    char *bad_dst = bad_ptr;
                     while (true)
                     {
-                        for (; *bad_ptr && (*bad_ptr != CR); bad_ptr++);
+                        for (; *bad_ptr && (*bad_ptr != CR); bad_ptr++)
+                            *bad_dst++ = *bad_ptr;
                         if (!*bad_ptr) break;
 
-                        char *bad_head = bad_ptr;
+                        char *bad_next = bad_ptr+1;
+                        if (*bad_next == LF) bad_next++;
 
-                        bad_ptr++;
-                        if (*bad_ptr == LF) bad_ptr++;
-
-                        if (strneql(bad_qbuf, bad_ptr, bad_qlen))
+                        if (strneql(bad_qbuf, bad_next, bad_qlen))
                         {
-                            *bad_head = ' ';
-
-                            memmove(bad_head+1, bad_ptr+bad_qlen, strlen(bad_ptr));
-                            bad_ptr = bad_head;
+                            *bad_dst++ = ' ';
+                            bad_ptr = bad_next+bad_qlen;
                         }
                         else
                             break;
                     }
+                    if (bad_dst != bad_ptr)
+                        memmove(bad_dst, bad_ptr, strlen(bad_ptr)+1);
                 }
 
                 // Get one line
@@ -99,6 +99,29 @@ static bool tokenxchg(std::string &input, std::string::iterator &pos,
 }
 
 
+//  ------------------------------------------------------------------
+//  Length of the token at str, up to the delimiter tokenxchg() wants
+
+static size_t tokenlen(const char* str)
+{
+    const char* ptr = str+1;
+    while (*ptr and not isspace(*ptr) and not ispunct(*ptr))
+        ptr++;
+    return ptr - str;
+}
+
+
+//  ------------------------------------------------------------------
+//  Does the token measured by tokenlen() match tok? Tested before the
+//  tokenxchg() calls, so their replacement text is only built for the
+//  token actually found.
+
+inline bool tokenis(const char* str, size_t len, const char* tok)
+{
+    return (strlen(tok) == len) and strnieql(str, tok, len);
+}
+
+
 //  ------------------------------------------------------------------
 
 static void translate(std::string &text)
@@ -139,6 +162,15 @@ inline bool domain_requested(const char *str, size_t pos)
 
 void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __origarea)
 {
+    // Most template lines hold no tokens, skip setting up for them
+    if (input.find('@') == input.npos)
+    {
+        std::string::iterator lf;
+        for (lf = input.begin(); lf != input.end(); lf++)
+            if (*lf == LF) *lf = CR;
+        return;
+    }
+
     static char revbuf[5] = "";
     if (revbuf[0] == NUL)
         gsprintf(PRINTF_DECLARE_BUFFER(revbuf), "%02d%02d", str2mon(__gver_date__), atoi(&__gver_date__[4]));
@@ -195,99 +227,102 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
         else if (*(dst+1) == '@') input.erase(dst);
         else
         {
-            if (tokenxchg(input, dst, "@cecho", AA->echoid()))
+            const char* tokstr = it2str(input, dst);
+            size_t toklen = tokenlen(tokstr);
+
+            if (tokenis(tokstr, toklen, "@cecho") and tokenxchg(input, dst, "@cecho", AA->echoid()))
                 continue;
 
-            if (tokenxchg(input, dst, "@cdesc", AA->desc()))
+            if (tokenis(tokstr, toklen, "@cdesc") and tokenxchg(input, dst, "@cdesc", AA->desc()))
                 continue;
 
-            if (tokenxchg(input, dst, "@oecho", origareaid))
+            if (tokenis(tokstr, toklen, "@oecho") and tokenxchg(input, dst, "@oecho", origareaid))
                 continue;
 
-            if (tokenxchg(input, dst, "@odesc", AL.AreaEchoToPtr(origareaid)->desc()))
+            if (tokenis(tokstr, toklen, "@odesc") and tokenxchg(input, dst, "@odesc", AL.AreaEchoToPtr(origareaid)->desc()))
                 continue;
 
-            if (tokenxchg(input, dst, "@oname", strbtrim(strtmp(oldmsg->By())), 34, 2,
+            if (tokenis(tokstr, toklen, "@oname") and tokenxchg(input, dst, "@oname", strbtrim(strtmp(oldmsg->By())), 34, 2,
                           (int)msg->by_me(), (int)msg->by_you()))
                 continue;
 
-            if (tokenxchg(input, dst, "@ofname", strlword(oldmsg->By()), 0, 2,
+            if (tokenis(tokstr, toklen, "@ofname") and tokenxchg(input, dst, "@ofname", strlword(oldmsg->By()), 0, 2,
                           (int)msg->by_me(), (int)msg->by_you()))
                 continue;
 
-            if (tokenxchg(input, dst, "@olname", strrword(oldmsg->By()), 0, 2,
+            if (tokenis(tokstr, toklen, "@olname") and tokenxchg(input, dst, "@olname", strrword(oldmsg->By()), 0, 2,
                           (int)msg->by_me(), (int)msg->by_you()))
                 continue;
 
-            if (tokenxchg(input, dst, "@odate", odate))
+            if (tokenis(tokstr, toklen, "@odate") and tokenxchg(input, dst, "@odate", odate))
                 continue;
 
-            if (tokenxchg(input, dst, "@otime", otime))
+            if (tokenis(tokstr, toklen, "@otime") and tokenxchg(input, dst, "@otime", otime))
                 continue;
 
-            if (tokenxchg(input, dst, "@odtime", odtime))
+            if (tokenis(tokstr, toklen, "@odtime") and tokenxchg(input, dst, "@odtime", odtime))
                 continue;
 
-            if (tokenxchg(input, dst, "@otzoffset", (oldmsg->tzutc == -32767) ? "" : (gsprintf(PRINTF_DECLARE_BUFFER(buf), " %+05d", oldmsg->tzutc), buf)))
+            if (tokenis(tokstr, toklen, "@otzoffset") and tokenxchg(input, dst, "@otzoffset", (oldmsg->tzutc == -32767) ? "" : (gsprintf(PRINTF_DECLARE_BUFFER(buf), " %+05d", oldmsg->tzutc), buf)))
                 continue;
 
-            if (tokenxchg(input, dst, "@ofrom", oldmsg->ifrom))
+            if (tokenis(tokstr, toklen, "@ofrom") and tokenxchg(input, dst, "@ofrom", oldmsg->ifrom))
                 continue;
 
-            if (tokenxchg(input, dst, "@oto", oldmsg->ito))
+            if (tokenis(tokstr, toklen, "@oto") and tokenxchg(input, dst, "@oto", oldmsg->ito))
                 continue;
 
-            if (tokenxchg(input, dst, "@omessageid", oldmsg->messageid ? oldmsg->messageid : ""))
+            if (tokenis(tokstr, toklen, "@omessageid") and tokenxchg(input, dst, "@omessageid", oldmsg->messageid ? oldmsg->messageid : ""))
                 continue;
 
-            if (tokenxchg(input, dst, "@omsgid", *msg->replys ? msg->replys : ""))
+            if (tokenis(tokstr, toklen, "@omsgid") and tokenxchg(input, dst, "@omsgid", *msg->replys ? msg->replys : ""))
                 continue;
 
-            if (tokenxchg(input, dst, "@dname", strbtrim(strtmp(oldmsg->To())), 34, 3,
+            if (tokenis(tokstr, toklen, "@dname") and tokenxchg(input, dst, "@dname", strbtrim(strtmp(oldmsg->To())), 34, 3,
                           (int)msg->to_me(), (int)msg->to_you(), (int)oldmsg->to_all()))
                 continue;
 
-            if (tokenxchg(input, dst, "@dpgp", *msg->iaddr ? msg->iaddr : msg->To()))
+            if (tokenis(tokstr, toklen, "@dpgp") and tokenxchg(input, dst, "@dpgp", *msg->iaddr ? msg->iaddr : msg->To()))
                 continue;
 
-            if (tokenxchg(input, dst, "@dfname", strlword(oldmsg->To()), 0, 3,
+            if (tokenis(tokstr, toklen, "@dfname") and tokenxchg(input, dst, "@dfname", strlword(oldmsg->To()), 0, 3,
                           (int)msg->to_me(), (int)msg->to_you(), (int)oldmsg->to_all()))
                 continue;
 
-            if (tokenxchg(input, dst, "@dlname", strrword(oldmsg->To()), 0, 3,
+            if (tokenis(tokstr, toklen, "@dlname") and tokenxchg(input, dst, "@dlname", strrword(oldmsg->To()), 0, 3,
                           (int)msg->to_me(), (int)msg->to_you(), (int)oldmsg->to_all()))
                 continue;
 
             if (origareaisinet)
             {
-                if (tokenxchg(input, dst, "@oaddr", oldmsg->iorig, 19, 1, 0))
+                if (tokenis(tokstr, toklen, "@oaddr") and tokenxchg(input, dst, "@oaddr", oldmsg->iorig, 19, 1, 0))
                     continue;
 
-                if (tokenxchg(input, dst, "@daddr", oldmsg->iaddr, 19, 1, 0))
+                if (tokenis(tokstr, toklen, "@daddr") and tokenxchg(input, dst, "@daddr", oldmsg->iaddr, 19, 1, 0))
                     continue;
             }
 
             if (currareaisinet)
             {
-                if (tokenxchg(input, dst, "@caddr", AA->Internetaddress(), 19, 1, 0))
+                if (tokenis(tokstr, toklen, "@caddr") and tokenxchg(input, dst, "@caddr", AA->Internetaddress(), 19, 1, 0))
                     continue;
 
-                if (tokenxchg(input, dst, "@faddr", msg->iorig, 19, 1, 0))
+                if (tokenis(tokstr, toklen, "@faddr") and tokenxchg(input, dst, "@faddr", msg->iorig, 19, 1, 0))
                     continue;
 
-                if (tokenxchg(input, dst, "@taddr", msg->iaddr, 19, 1, 0))
+                if (tokenis(tokstr, toklen, "@taddr") and tokenxchg(input, dst, "@taddr", msg->iaddr, 19, 1, 0))
                     continue;
             }
 
-            if ((not origareaisinet or not currareaisinet) and (strlen(it2str(input, dst)) >= 6))
+            if ((not origareaisinet or not currareaisinet) and ((input.end()-dst) >= 6))
             {
                 bool dr = domain_requested(it2str(input, dst), 6);
                 if (not origareaisinet)
                 {
-                    if (tokenxchg(input, dst, "@oaddr", oldmsg->orig.make_string(buf, dr ? oldmsg->odom : NULL), 19, 1, 0))
+                    if (tokenis(tokstr, toklen, "@oaddr") and tokenxchg(input, dst, "@oaddr", oldmsg->orig.make_string(buf, dr ? oldmsg->odom : NULL), 19, 1, 0))
                         continue;
 
-                    if (strnieql(it2str(input, dst), "@o3daddr", 8))
+                    if (tokenis(tokstr, toklen, "@o3daddr"))
                     {
                         ftn_addr boss = oldmsg->orig;
                         boss.point = 0;
@@ -295,10 +330,10 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                         continue;
                     }
 
-                    if (tokenxchg(input, dst, "@daddr", oldmsg->dest.make_string(buf, dr ? oldmsg->ddom : NULL), 19, 1, 0))
+                    if (tokenis(tokstr, toklen, "@daddr") and tokenxchg(input, dst, "@daddr", oldmsg->dest.make_string(buf, dr ? oldmsg->ddom : NULL), 19, 1, 0))
                         continue;
 
-                    if (strnieql(it2str(input, dst), "@d3daddr", 8))
+                    if (tokenis(tokstr, toklen, "@d3daddr"))
                     {
                         ftn_addr boss = oldmsg->dest;
                         boss.point = 0;
@@ -310,10 +345,10 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 if (not currareaisinet)
                 {
                     const gaka &caka=AA->Aka();
-                    if (tokenxchg(input, dst, "@caddr", caka.addr.make_string(buf, dr ? caka.domain : NULL), 19, 1, 0))
+                    if (tokenis(tokstr, toklen, "@caddr") and tokenxchg(input, dst, "@caddr", caka.addr.make_string(buf, dr ? caka.domain : NULL), 19, 1, 0))
                         continue;
 
-                    if (strnieql(it2str(input, dst), "@c3daddr", 8))
+                    if (tokenis(tokstr, toklen, "@c3daddr"))
                     {
                         ftn_addr boss = caka.addr;
                         boss.point = 0;
@@ -321,10 +356,10 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                         continue;
                     }
 
-                    if (tokenxchg(input, dst, "@taddr", msg->dest.make_string(buf, dr ? msg->ddom : NULL), 19, 1, 0))
+                    if (tokenis(tokstr, toklen, "@taddr") and tokenxchg(input, dst, "@taddr", msg->dest.make_string(buf, dr ? msg->ddom : NULL), 19, 1, 0))
                         continue;
 
-                    if (strnieql(it2str(input, dst), "@t3daddr", 8))
+                    if (tokenis(tokstr, toklen, "@t3daddr"))
                     {
                         ftn_addr boss = msg->dest;
                         boss.point = 0;
@@ -332,10 +367,10 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                         continue;
                     }
 
-                    if (tokenxchg(input, dst, "@faddr", msg->orig.make_string(buf, dr ? msg->odom : NULL), 19, 1, 0))
+                    if (tokenis(tokstr, toklen, "@faddr") and tokenxchg(input, dst, "@faddr", msg->orig.make_string(buf, dr ? msg->odom : NULL), 19, 1, 0))
                         continue;
 
-                    if (strnieql(it2str(input, dst), "@f3daddr", 8))
+                    if (tokenis(tokstr, toklen, "@f3daddr"))
                     {
                         ftn_addr boss = msg->orig;
                         boss.point = 0;
@@ -345,58 +380,58 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 }
             }
 
-            if (tokenxchg(input, dst, "@tname", strbtrim(strtmp(msg->To())), 34, 3,
+            if (tokenis(tokstr, toklen, "@tname") and tokenxchg(input, dst, "@tname", strbtrim(strtmp(msg->To())), 34, 3,
                           (int)false, (int)false, (int)msg->to_all()))
                 continue;
 
-            if (tokenxchg(input, dst, "@tfname", strlword(msg->To()), 0, 3,
+            if (tokenis(tokstr, toklen, "@tfname") and tokenxchg(input, dst, "@tfname", strlword(msg->To()), 0, 3,
                           (int)false, (int)false, (int)msg->to_all()))
                 continue;
 
-            if (tokenxchg(input, dst, "@tlname", strrword(msg->To()), 0, 3,
+            if (tokenis(tokstr, toklen, "@tlname") and tokenxchg(input, dst, "@tlname", strrword(msg->To()), 0, 3,
                           (int)false, (int)false, (int)msg->to_all()))
                 continue;
 
-            if (tokenxchg(input, dst, "@cname", AA->Username().name, 34))
+            if (tokenis(tokstr, toklen, "@cname") and tokenxchg(input, dst, "@cname", AA->Username().name, 34))
                 continue;
 
-            if (tokenxchg(input, dst, "@cfname", strlword(strcpy(buf, AA->Username().name))))
+            if (tokenis(tokstr, toklen, "@cfname") and tokenxchg(input, dst, "@cfname", strlword(strcpy(buf, AA->Username().name))))
                 continue;
 
-            if (tokenxchg(input, dst, "@clname", strrword(strcpy(buf, AA->Username().name))))
+            if (tokenis(tokstr, toklen, "@clname") and tokenxchg(input, dst, "@clname", strrword(strcpy(buf, AA->Username().name))))
                 continue;
 
-            if (tokenxchg(input, dst, "@cfrom", msg->ifrom))
+            if (tokenis(tokstr, toklen, "@cfrom") and tokenxchg(input, dst, "@cfrom", msg->ifrom))
                 continue;
 
-            if (tokenxchg(input, dst, "@cto", msg->ito))
+            if (tokenis(tokstr, toklen, "@cto") and tokenxchg(input, dst, "@cto", msg->ito))
                 continue;
 
-            if (tokenxchg(input, dst, "@cdate", cdate))
+            if (tokenis(tokstr, toklen, "@cdate") and tokenxchg(input, dst, "@cdate", cdate))
                 continue;
 
-            if (tokenxchg(input, dst, "@ctime", ctime))
+            if (tokenis(tokstr, toklen, "@ctime") and tokenxchg(input, dst, "@ctime", ctime))
                 continue;
 
-            if (tokenxchg(input, dst, "@cdtime", cdtime))
+            if (tokenis(tokstr, toklen, "@cdtime") and tokenxchg(input, dst, "@cdtime", cdtime))
                 continue;
 
-            if (tokenxchg(input, dst, "@ctzoffset", AA->Usetzutc() ? (gsprintf(PRINTF_DECLARE_BUFFER(buf), " %+05d", tzoffset()), buf) : ""))
+            if (tokenis(tokstr, toklen, "@ctzoffset") and tokenxchg(input, dst, "@ctzoffset", AA->Usetzutc() ? (gsprintf(PRINTF_DECLARE_BUFFER(buf), " %+05d", tzoffset()), buf) : ""))
                 continue;
 
-            if (tokenxchg(input, dst, "@fname", strbtrim(strtmp(msg->By())), 34))
+            if (tokenis(tokstr, toklen, "@fname") and tokenxchg(input, dst, "@fname", strbtrim(strtmp(msg->By())), 34))
                 continue;
 
-            if (tokenxchg(input, dst, "@fpgp", *msg->iorig ? msg->iorig : msg->By()))
+            if (tokenis(tokstr, toklen, "@fpgp") and tokenxchg(input, dst, "@fpgp", *msg->iorig ? msg->iorig : msg->By()))
                 continue;
 
-            if (tokenxchg(input, dst, "@ffname", strlword(msg->By())))
+            if (tokenis(tokstr, toklen, "@ffname") and tokenxchg(input, dst, "@ffname", strlword(msg->By())))
                 continue;
 
-            if (tokenxchg(input, dst, "@flname", strrword(msg->By())))
+            if (tokenis(tokstr, toklen, "@flname") and tokenxchg(input, dst, "@flname", strrword(msg->By())))
                 continue;
 
-            if (strnieql(it2str(input, dst), "@dpseudo", 8))
+            if (tokenis(tokstr, toklen, "@dpseudo"))
             {
                 if (*(oldmsg->pseudoto) == NUL)
                     build_pseudo(oldmsg);
@@ -404,7 +439,7 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 continue;
             }
 
-            if (strnieql(it2str(input, dst), "@opseudo", 8))
+            if (tokenis(tokstr, toklen, "@opseudo"))
             {
                 if (*(oldmsg->pseudofrom) == NUL)
                     build_pseudo(oldmsg, false);
@@ -412,7 +447,7 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 continue;
             }
 
-            if (strnieql(it2str(input, dst), "@tpseudo", 8))
+            if (tokenis(tokstr, toklen, "@tpseudo"))
             {
                 if (*(msg->pseudoto) == NUL)
                     build_pseudo(msg);
@@ -421,7 +456,7 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
             }
 
             // Same as above (just for backward compatibility)
-            if (strnieql(it2str(input, dst), "@pseudo", 7))
+            if (tokenis(tokstr, toklen, "@pseudo"))
             {
                 if (*(msg->pseudoto) == NUL)
                     build_pseudo(msg);
@@ -429,7 +464,7 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 continue;
             }
 
-            if (strnieql(it2str(input, dst), "@fpseudo", 8))
+            if (tokenis(tokstr, toklen, "@fpseudo"))
             {
                 if (*(msg->pseudofrom) == NUL)
                     build_pseudo(msg, false);
@@ -437,54 +472,54 @@ void TokenXlat(int mode, std::string &input, GMsg* msg, GMsg* oldmsg, int __orig
                 continue;
             }
 
-            if (tokenxchg(input, dst, "@msgno", msgno))
+            if (tokenis(tokstr, toklen, "@msgno") and tokenxchg(input, dst, "@msgno", msgno))
                 continue;
 
-            if (tokenxchg(input, dst, "@msgs", msgs))
+            if (tokenis(tokstr, toklen, "@msgs") and tokenxchg(input, dst, "@msgs", msgs))
                 continue;
 
-            if (tokenxchg(input, dst, "@cpseudo", *AA->Nickname() ? AA->Nickname() : strlword(strcpy(buf, AA->Username().name), " @.")))
+            if (tokenis(tokstr, toklen, "@cpseudo") and tokenxchg(input, dst, "@cpseudo", *AA->Nickname() ? AA->Nickname() : strlword(strcpy(buf, AA->Username().name), " @.")))
                 continue;
 
-            if (tokenxchg(input, dst, "@version", __gver_ver__))
+            if (tokenis(tokstr, toklen, "@version") and tokenxchg(input, dst, "@version", __gver_ver__))
                 continue;
 
-            if (tokenxchg(input, dst, "@ver", __gver_shortver__))
+            if (tokenis(tokstr, toklen, "@ver") and tokenxchg(input, dst, "@ver", __gver_shortver__))
                 continue;
 
-            if (tokenxchg(input, dst, "@rev", revbuf))
+            if (tokenis(tokstr, toklen, "@rev") and tokenxchg(input, dst, "@rev", revbuf))
                 continue;
 
-            if (tokenxchg(input, dst, "@pid", __gver_shortpid__))
+            if (tokenis(tokstr, toklen, "@pid") and tokenxchg(input, dst, "@pid", __gver_shortpid__))
                 continue;
 
-            if (tokenxchg(input, dst, "@longpid", __gver_longpid__))
+            if (tokenis(tokstr, toklen, "@longpid") and tokenxchg(input, dst, "@longpid", __gver_longpid__))
                 continue;
 
-            if (tokenxchg(input, dst, "@widepid", xmailer))
+            if (tokenis(tokstr, toklen, "@widepid") and tokenxchg(input, dst, "@widepid", xmailer))
                 continue;
 
-            if (tokenxchg(input, dst, "@osver", osver))
+            if (tokenis(tokstr, toklen, "@osver") and tokenxchg(input, dst, "@osver", osver))
                 continue;
 
-            if (tokenxchg(input, dst, "@osslash", __gver_platform__))
+            if (tokenis(tokstr, toklen, "@osslash") and tokenxchg(input, dst, "@osslash", __gver_platform__))
                 continue;
 
-            if (tokenxchg(input, dst, "@subject", modereptr))
+            if (tokenis(tokstr, toklen, "@subject") and tokenxchg(input, dst, "@subject", modereptr))
                 continue;
 
-            if (tokenxchg(input, dst, "@attr", attr))
+            if (tokenis(tokstr, toklen, "@attr") and tokenxchg(input, dst, "@attr", attr))
                 continue;
 
-            if (tokenxchg(input, dst, "@tagline",
+            if (tokenis(tokstr, toklen, "@tagline") and tokenxchg(input, dst, "@tagline",
                           HandleRandomLine(strxcpy(buf, AA->Tagline(), sizeof(buf)), sizeof(buf))))
                 continue;
 
-            if (tokenxchg(input, dst, "@tearline",
+            if (tokenis(tokstr, toklen, "@tearline") and tokenxchg(input, dst, "@tearline",
                           HandleRandomLine(strxcpy(buf, AA->Tearline(), sizeof(buf)), sizeof(buf))))
                 continue;
 
-            if (tokenxchg(input, dst, "@origin",
+            if (tokenis(tokstr, toklen, "@origin") and tokenxchg(input, dst, "@origin",
                           HandleRandomLine(strxcpy(buf, AA->Origin(), sizeof(buf)), sizeof(buf))))
                 continue;
 
@@ -35,6 +35,7 @@
 //  Static data for the browser and associated functions
 
 static ftn_nodelist_index_base* NLP = NULL;
+static bool                     NLP_session = false;
 static ftn_nodelist_entry       entry;
 
 
@@ -708,8 +709,8 @@ int NodelistBrowser::DoKey(gkey& keycode)
 
             if(matchaddr.net)
                 NLP->find(matchaddr);
-            else
-                NLP->find(user_maybe);
+            else if(not NLP->find(user_maybe))
+                NLP->find_similar(user_maybe);
             InitDisplay();
         }
         else
@@ -863,10 +864,19 @@ static bool NLP_open()
     }
     else
     {
-        CheckNodelists();
-        NLP = new ftn_golded_nodelist_index;
-        throw_new(NLP);
-        NLP->set_path(CFG->nodepath);
+        // The GoldED index is kept open for the session and only
+        // reloaded when GoldNode has rebuilt it
+        bool changed = CheckNodelists();
+        if(NLP == NULL)
+        {
+            NLP = new ftn_golded_nodelist_index;
+            throw_new(NLP);
+            NLP->set_path(CFG->nodepath);
+            NLP_session = true;
+        }
+        if(changed or not NLP->is_open())
+            return NLP->open();
+        return true;
     }
 
     return NLP->open();
@@ -878,11 +888,31 @@ static bool NLP_open()
 static void NLP_close()
 {
 
+    if(NLP_session)
+    {
+        NLP->release();
+        return;
+    }
+
     NLP->close();
     throw_delete(NLP);
 }
 
 
+//  ------------------------------------------------------------------
+
+static void NLP_done()
+{
+
+    if(NLP)
+    {
+        NLP->close();
+        throw_delete(NLP);
+    }
+    NLP_session = false;
+}
+
+
 //  ------------------------------------------------------------------
 
 static Name nlname;
@@ -1102,7 +1132,11 @@ void Lookup(GMsg* msg, Addr* addr, char* name, int topline, char* status)
         {
 
             if(namelookup)
-                NLP->find(name);
+            {
+                // Open the browser on the nearest misspelling
+                if(not NLP->find(name) and (topline != -100))
+                    NLP->find_similar(name);
+            }
             else
                 NLP->find(matchaddr);
 
@@ -1217,6 +1251,7 @@ std::vector<location_item> g_LocationCache;
 void LookupNodeClear()
 {
     g_LocationCache.clear();
+    NLP_done();
 }
 
 void LookupNodeLocation(GMsg* msg, std::string &location, int what)
@@ -1347,7 +1382,7 @@ void LookupNode(GMsg* msg, const char* name, int what)
 
 //  ------------------------------------------------------------------
 
-void CheckNodelists()
+bool CheckNodelists()
 {
 
     // Copy of previous timestamp
@@ -1359,7 +1394,8 @@ void CheckNodelists()
     time32_t ft = GetFiletime(file);
 
     // Check nodelists if timestamp changed
-    if(ft != oldft)
+    bool changed = (ft != oldft);
+    if(changed)
     {
 
         // Keep copy of timestamp for later lookups
@@ -1420,6 +1456,8 @@ void CheckNodelists()
 
     throw_release(NODE->nodelist);
     NODE->nodelists = 0;
+
+    return changed;
 }
 
 //  ------------------------------------------------------------------
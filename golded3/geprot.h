@@ -309,7 +309,7 @@ const char *lookup_nodelist(ftn_addr* addr);
 void LookupNodeLocation(GMsg* msg, std::string &location, int what);
 void LookupNode(GMsg* msg, const char* name, int what);
 void LookupNodeClear();
-void CheckNodelists();
+bool CheckNodelists();
 
 
 //  ------------------------------------------------------------------
@@ -489,6 +489,7 @@ bool  doinvalidate(std::string& text, const std::string& find, const std::string
 bool find(const std::vector<const char *> &vec, const char *str);
 bool find(const std::vector<std::string> &vec, const std::string &str);
 vattr GetColorName(const char *name, Addr &addr, vattr color);
+void  ColorNameReset();
 
 
 //  ------------------------------------------------------------------
@@ -191,6 +191,7 @@ void Area::InitData()
     adat->inittwit = true;
     adat->twitname = CFG->twitname;
     adat->twitsubj = CFG->twitsubj;
+    adat->twitfilter.Reset();
     adat->usearea = CFG->usearea;
     adat->usefwd = CFG->usefwd;
     strcpy(adat->username.name, CFG->username.empty() ? "" : CFG->username[CFG->usernameno].name);
@@ -423,6 +424,7 @@ void Area::RandomizeData(int mode)
                 adat->twitsubj.push_back(subj);
             }
 
+            adat->twitfilter.Reset();
             adat->inittwit = false;
         }
 
@@ -1182,52 +1182,157 @@ uint32_t MsgHasReplies(GMsg* msg)
 
 
 //  ------------------------------------------------------------------
-//  Determine if the message is of the "twit" type
+//  Sort the twit lists into lookup tables. Names without wildcards are
+//  looked up directly, as are addresses of rules with an empty name.
 
-int MsgIsTwit(GMsg* msg, bool& istwitto, bool& istwitsubj)
+void TwitFilter::Compile(const std::vector<Node>& twitname, const gstrarray& twitsubj)
 {
 
-    bool istwit = false;
-    istwitto = istwitsubj = false;
+    names.clear();
+    addrs.clear();
+    others.clear();
+    for(int c=0; c<256; c++)
+        subjs[c].clear();
+    subjsany.clear();
 
-    // Check for twit names
-    std::vector<Node>::iterator tn;
-    for(tn = AA->adat->twitname.begin(); tn != AA->adat->twitname.end(); tn++)
+    std::string key;
+    for(int n=0; n<(int)twitname.size(); n++)
     {
-        if(msg->orig.match(tn->addr))
+        const Node& tn = twitname[n];
+        const Addr& a = tn.addr;
+        bool mask = (a.zone == GFTN_ALL) or (a.net == GFTN_ALL) or (a.node == GFTN_ALL) or (a.point == GFTN_ALL);
+        if(*tn.name == NUL)
         {
-            if(*tn->name == NUL or strwild(msg->By(), tn->name))
+            if(mask)
+                others.push_back(n);
+            else
+                addrs.insert(std::pair<Addr, int>(a, n));
+        }
+        else if(strpbrk(tn.name, "*?"))
+            others.push_back(n);
+        else
+        {
+            key = tn.name;
+            strupr(key);
+            names[key].push_back(n);
+        }
+    }
+
+    for(int s=0; s<(int)twitsubj.size(); s++)
+    {
+        byte c = (byte)*twitsubj[s].c_str();
+        if((c == NUL) or (c >= 0x80))
+            subjsany.push_back(s);
+        else
+            subjs[g_tolower(c)].push_back(s);
+    }
+
+    compiled = true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Returns the first TWITNAME rule matching the name and address, or
+//  INT_MAX if there is none
+
+int TwitFilter::MatchName(const std::vector<Node>& twitname, const char* name, const Addr& addr) const
+{
+
+    int rule = INT_MAX;
+
+    std::string key = name;
+    strupr(key);
+    std::map<std::string, std::vector<int> >::const_iterator l = names.find(key);
+    if(l != names.end())
+    {
+        std::vector<int>::const_iterator n;
+        for(n = l->second.begin(); n != l->second.end(); n++)
+        {
+            if(addr.match(twitname[*n].addr))
             {
-                istwit = true;
+                rule = *n;
                 break;
             }
         }
-        if(CFG->switches.get(twitto))
+    }
+
+    std::map<Addr, int, TwitAddrLess>::const_iterator a = addrs.find(addr);
+    if((a != addrs.end()) and (a->second < rule))
+        rule = a->second;
+
+    std::vector<int>::const_iterator o;
+    for(o = others.begin(); (o != others.end()) and (*o < rule); o++)
+    {
+        const Node& tn = twitname[*o];
+        if(addr.match(tn.addr) and ((*tn.name == NUL) or strwild(name, tn.name)))
         {
-            if(msg->dest.match(tn->addr))
-            {
-                if(*tn->name == NUL or strwild(msg->To(), tn->name))
-                {
-                    istwitto = true;
-                    istwit = true;
-                    break;
-                }
-            }
+            rule = *o;
+            break;
+        }
+    }
+
+    return rule;
+}
+
+
+//  ------------------------------------------------------------------
+
+bool TwitFilter::MatchSubj(const gstrarray& twitsubj, const char* subj) const
+{
+
+    std::vector<int>::const_iterator n;
+    for(n = subjsany.begin(); n != subjsany.end(); n++)
+        if(striinc(twitsubj[*n].c_str(), subj))
+            return true;
+
+    for(const char* p=subj; *p; p++)
+    {
+        const std::vector<int>& bucket = subjs[g_tolower((byte)*p)];
+        for(n = bucket.begin(); n != bucket.end(); n++)
+        {
+            const std::string& s = twitsubj[*n];
+            if(not strnicmp(s.c_str(), p, s.length()))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+//  ------------------------------------------------------------------
+//  Determine if the message is of the "twit" type
+
+int MsgIsTwit(GMsg* msg, bool& istwitto, bool& istwitsubj)
+{
+
+    bool istwit = false;
+    istwitto = istwitsubj = false;
+
+    TwitFilter& tf = AA->adat->twitfilter;
+    if(not tf.compiled)
+        tf.Compile(AA->adat->twitname, AA->adat->twitsubj);
+
+    // Check for twit names. The first rule matching either the sender
+    // or, with TWITTO, the recipient decides.
+    if(not AA->adat->twitname.empty())
+    {
+        int byrule = tf.MatchName(AA->adat->twitname, msg->By(), msg->orig);
+        int torule = CFG->switches.get(twitto) ? tf.MatchName(AA->adat->twitname, msg->To(), msg->dest) : INT_MAX;
+        if(byrule != INT_MAX or torule != INT_MAX)
+        {
+            istwit = true;
+            istwitto = (torule < byrule);
         }
     }
 
     // Check for twit subjects
     if(not istwit)
     {
-        gstrarray::iterator n;
-        for(n = AA->adat->twitsubj.begin(); n != AA->adat->twitsubj.end(); n++)
+        if(tf.MatchSubj(AA->adat->twitsubj, msg->re))
         {
-            if(striinc(n->c_str(), msg->re))
-            {
-                istwitsubj = true;
-                istwit = true;
-                break;
-            }
+            istwitsubj = true;
+            istwit = true;
         }
     }
 
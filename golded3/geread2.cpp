@@ -25,6 +25,7 @@
 //  ------------------------------------------------------------------
 
 #include <vector>
+#include <set>
 #include <algorithm>
 #include <golded.h>
 #include <gwinput.h>
@@ -926,6 +927,32 @@ void ReadPeekURLs(GMsg* msg)
 }
 
 
+//  ------------------------------------------------------------------
+//  Write the lines of a loaded message as plain text for uulib.
+//  Control codes are masked the same way SaveLines() does it.
+
+static void UUWriteLines(gfile& fp, GMsg* msg)
+{
+
+    Line** lin = msg->line;
+    if(lin)
+    {
+        for(int n=0; lin[n]; n++)
+        {
+            std::string& txt = lin[n]->txt;
+            for(std::string::iterator p = txt.begin(); p != txt.end(); p++)
+            {
+                if(iscntrl(*p) and (*p != '\x1B'))
+                    *p = (*p == CTRL_A) ? '@' : '.';
+            }
+            fp.Fwrite(txt.c_str(), txt.length());
+            fp.Fwrite("\n", 1);
+        }
+    }
+    fp.Fwrite("\n", 1);
+}
+
+
 //  ------------------------------------------------------------------
 
 void UUDecode(GMsg* msg)
@@ -952,7 +979,6 @@ void UUDecode(GMsg* msg)
         GMenuDomarks MenuDomarks;
 
         int source = AA->Mark.Count() ? MenuDomarks.Run(LNG->Decode) : WRITE_CURRENT;
-        bool overwrite = true;
 
         if(source == WRITE_QUIT)
             return;
@@ -960,23 +986,29 @@ void UUDecode(GMsg* msg)
         bool old_quotespacing = CFG->switches.get(quotespacing);
         CFG->switches.set(quotespacing, false);
 
-        if(source == WRITE_MARKED)
+        // All messages go through one open file and are loaded only
+        // once; SaveLines() would reopen the file and reload each one.
+        gfile fp(infile, "wt", CFG->sharemode);
+        if(fp.isopen())
         {
-            for(uint n=0; n<AA->Mark.Count(); n++)
+            fp.SetvBuf(NULL, _IOFBF, 65535);
+            if(source == WRITE_MARKED)
             {
-                if(overwrite and n)
-                    overwrite = false;  // Overwrite only the first time
-                w_progress(MODE_UPDATE, C_INFOW, n+1, AA->Mark.Count(), LNG->Preparing);
-                AA->LoadMsg(msg, AA->Mark[n], 79);
-                SaveLines(overwrite ? MODE_WRITE : MODE_APPEND, infile, msg, 79);
+                for(uint n=0; n<AA->Mark.Count(); n++)
+                {
+                    w_progress(MODE_UPDATE, C_INFOW, n+1, AA->Mark.Count(), LNG->Preparing);
+                    if(AA->LoadMsg(msg, AA->Mark[n], 79))
+                        UUWriteLines(fp, msg);
+                }
+                if(AA->Mark.Count())
+                    w_progress(MODE_QUIT, BLACK_|_BLACK, 0, 0, NULL);
             }
-            if(AA->Mark.Count())
-                w_progress(MODE_QUIT, BLACK_|_BLACK, 0, 0, NULL);
-        }
-        else if(source == WRITE_CURRENT)
-        {
-            AA->LoadMsg(msg, msg->msgno, 79);
-            SaveLines(MODE_WRITE, infile, msg, 79);
+            else if(source == WRITE_CURRENT)
+            {
+                if(AA->LoadMsg(msg, msg->msgno, 79))
+                    UUWriteLines(fp, msg);
+            }
+            fp.Fclose();
         }
 
         CFG->switches.set(quotespacing, old_quotespacing);
@@ -1023,15 +1055,18 @@ void UUDecode(GMsg* msg)
 
 void Make_Userlist(const char* userlist)
 {
-    word* crclist;
-    word crc, crcs=0;
-    uint n, x;
+    uint n;
     char userline[80], adrs[40];
 
+    // Names are compared exactly, as the old CRC16 list did, but
+    // without false matches.  The raw header name decides whether the
+    // full message must be loaded at all; the full load supplies the
+    // recoded name and the origin address that get written.
+    std::set<std::string> seen, written;
+
     GMsg* msg = new GMsg();
     throw_new(msg);
 
-    crclist = (word*)throw_calloc(AA->Msgn.Count()+1, sizeof(word));
     gfile fp(userlist, "ab", CFG->sharemode);
     if (fp.isopen())
     {
@@ -1040,20 +1075,19 @@ void Make_Userlist(const char* userlist)
         {
             update_statuslinef(LNG->ReadingMsg, "ST_READINGMSG", n, AA->Msgn.Count());
             w_progress(MODE_UPDATE, C_INFOW, (AA->Msgn.Count()-n)+1, AA->Msgn.Count(), NULL);
-            AA->LoadMsg(msg, AA->Msgn.CvtReln(n), CFG->dispmargin);
-            crc = strCrc16(msg->by, false);
-            for(x=0; x<crcs; x++)
-                if(crclist[x] == crc)
-                    break;  // We have already used it
-            if (x >= crcs)
+            uint32_t msgno = AA->Msgn.CvtReln(n);
+            if(not AA->LoadHdr(msg, msgno, false))
+                continue;
+            if(not seen.insert(msg->by).second)
+                continue;   // We have already used it
+            AA->LoadMsg(msg, msgno, CFG->dispmargin);
+            if(written.insert(msg->by).second)
             {
-                crclist[crcs++] = crc;
                 strrevname(userline, msg->by);
                 msg->orig.make_string(adrs);
                 fp.Printf("%-36.36s%24.24s\r\n", userline, adrs);
             }
         }
-        throw_free(crclist);
         w_progress(MODE_QUIT, BLACK_|_BLACK, 0, 0, NULL);
     }
 
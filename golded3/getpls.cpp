@@ -46,6 +46,14 @@ extern bool reader_gen_confirm;
 
 const int REALLOC_CACHE_SIZE = 4096;
 
+//  Slack to add when msg->txt is full. It grows with the text, so that
+//  long messages and quotes are not copied over for every 4K added.
+
+inline size_t realloc_cache_size(size_t size)
+{
+    return MaxV(size_t(REALLOC_CACHE_SIZE), size);
+}
+
 //  ------------------------------------------------------------------
 
 bool is_user(const char* name)
@@ -688,7 +696,7 @@ int TemplateToText(int mode, GMsg* msg, GMsg* oldmsg, const char* tpl, int origa
                                             }
                                             else
                                             {
-                                                msg_txt_realloc_cache += REALLOC_CACHE_SIZE;
+                                                msg_txt_realloc_cache += realloc_cache_size(size);
                                                 msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
                                             }
                                             strcpy(&(msg->txt[pos]), buf);
@@ -725,7 +733,7 @@ int TemplateToText(int mode, GMsg* msg, GMsg* oldmsg, const char* tpl, int origa
                                 }
                                 else
                                 {
-                                    msg_txt_realloc_cache += REALLOC_CACHE_SIZE;
+                                    msg_txt_realloc_cache += realloc_cache_size(size);
                                     msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
                                 }
                                 strcpy(&(msg->txt[pos]), buf);
@@ -884,7 +892,7 @@ int TemplateToText(int mode, GMsg* msg, GMsg* oldmsg, const char* tpl, int origa
                             }
                             else
                             {
-                                msg_txt_realloc_cache += REALLOC_CACHE_SIZE;
+                                msg_txt_realloc_cache += realloc_cache_size(MaxV(size_t(size), oldmsg_size));
                                 msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
                             }
                             strcpy(&(msg->txt[pos]), buf);
@@ -933,7 +941,7 @@ int TemplateToText(int mode, GMsg* msg, GMsg* oldmsg, const char* tpl, int origa
                                 }
                                 else
                                 {
-                                    msg_txt_realloc_cache += (size <= oldmsg_size) ? oldmsg_size : REALLOC_CACHE_SIZE;
+                                    msg_txt_realloc_cache += (size <= oldmsg_size) ? oldmsg_size : realloc_cache_size(size);
                                     msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
                                 }
                                 strcpy(&(msg->txt[pos]), tmpLine.c_str());
@@ -975,7 +983,7 @@ int TemplateToText(int mode, GMsg* msg, GMsg* oldmsg, const char* tpl, int origa
             }
             else
             {
-                msg_txt_realloc_cache += REALLOC_CACHE_SIZE;
+                msg_txt_realloc_cache += realloc_cache_size(size);
                 msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
             }
             strcpy(&(msg->txt[pos]), buf);
@@ -1036,7 +1044,7 @@ loop_next:
                     }
                     else
                     {
-                        msg_txt_realloc_cache += REALLOC_CACHE_SIZE;
+                        msg_txt_realloc_cache += realloc_cache_size(size);
                         msg->txt = (char*)throw_realloc(msg->txt, size+10+msg_txt_realloc_cache);
                     }
                     strcpy(&(msg->txt[pos]), buf);
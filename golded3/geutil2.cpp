@@ -371,6 +371,144 @@ void ScreenBlankIdle()
 }
 
 
+//  ------------------------------------------------------------------
+
+//  COLORNAME rules are compiled on first use into lookup tables, and
+//  recent results are kept in a small cache. The first matching rule
+//  in configuration order wins, as before.
+
+struct ColorAddrLess
+{
+    bool operator()(const Addr& a, const Addr& b) const
+    {
+        return a.compare(b) < 0;
+    }
+};
+
+struct ColorNameCache
+{
+    bool        used;
+    bool        hasname;
+    std::string name;
+    Addr        addr;
+    int         rule;
+};
+
+const int COLORNAME_CACHE = 64;
+const int COLORNAME_NONE  = INT_MAX;
+
+static bool                                 colorname_compiled = false;
+static std::map<Addr, int, ColorAddrLess>   colorname_addrs;    // Exact addresses
+static std::vector<int>                     colorname_masks;    // Addresses with wildcards
+static std::map<std::string, int>           colorname_names;    // Literal names
+static std::vector<int>                     colorname_wilds;    // Names with wildcards
+static ColorNameCache                       colorname_cache[COLORNAME_CACHE];
+
+
+//  ------------------------------------------------------------------
+
+static void ColorNameKey(std::string& key, const char* name)
+{
+
+    key.erase();
+    while(*name)
+        key += (char)g_tolower(*name++);
+}
+
+
+//  ------------------------------------------------------------------
+
+static void ColorNameCompile()
+{
+
+    colorname_addrs.clear();
+    colorname_masks.clear();
+    colorname_names.clear();
+    colorname_wilds.clear();
+
+    std::string key;
+    for (int n = 0; n < (int)CFG->colorname.size(); n++)
+    {
+        const Node& node = CFG->colorname[n].first;
+        const Addr& a = node.addr;
+
+        if ((a.zone == GFTN_ALL) or (a.net == GFTN_ALL) or (a.node == GFTN_ALL) or (a.point == GFTN_ALL))
+            colorname_masks.push_back(n);
+        else
+            colorname_addrs.insert(std::pair<Addr, int>(a, n));
+
+        if (strpbrk(node.name, "*?[\\"))
+            colorname_wilds.push_back(n);
+        else
+        {
+            ColorNameKey(key, node.name);
+            colorname_names.insert(std::pair<std::string, int>(key, n));
+        }
+    }
+
+    for (int c = 0; c < COLORNAME_CACHE; c++)
+        colorname_cache[c].used = false;
+
+    colorname_compiled = true;
+}
+
+
+//  ------------------------------------------------------------------
+
+void ColorNameReset()
+{
+
+    colorname_compiled = false;
+}
+
+
+//  ------------------------------------------------------------------
+
+static int ColorNameRule(const char *name, Addr &addr, bool addr_valid, bool name_valid)
+{
+
+    int rule = COLORNAME_NONE;
+
+    if (addr_valid)
+    {
+        std::map<Addr, int, ColorAddrLess>::iterator a = colorname_addrs.find(addr);
+        if (a != colorname_addrs.end())
+            rule = a->second;
+
+        std::vector<int>::iterator m;
+        for (m = colorname_masks.begin(); (m != colorname_masks.end()) and (*m < rule); m++)
+        {
+            if (addr.match(CFG->colorname[*m].first.addr))
+            {
+                rule = *m;
+                break;
+            }
+        }
+    }
+
+    if (name_valid)
+    {
+        std::string key;
+        ColorNameKey(key, name);
+        std::map<std::string, int>::iterator l = colorname_names.find(key);
+        if ((l != colorname_names.end()) and (l->second < rule))
+            rule = l->second;
+
+        std::vector<int>::iterator w;
+        for (w = colorname_wilds.begin(); (w != colorname_wilds.end()) and (*w < rule); w++)
+        {
+            if (gwildmat(name, CFG->colorname[*w].first.name))
+            {
+                rule = *w;
+                break;
+            }
+        }
+    }
+
+    return rule;
+}
+
+
 //  ------------------------------------------------------------------
 
 vattr GetColorName(const char *name, Addr &addr, vattr color)
@@ -381,16 +519,35 @@ vattr GetColorName(const char *name, Addr &addr, vattr color)
     if (!addr_valid && !name_valid)
         return color;
 
-    std::vector< std::pair<Node, vattr> >::iterator it;
-    for (it = CFG->colorname.begin(); it != CFG->colorname.end(); it++)
+    if (CFG->colorname.empty())
+        return color;
+
+    if (not colorname_compiled)
+        ColorNameCompile();
+
+    dword hash = addr_valid ? ((dword)addr.zone*31 + addr.net)*31 + addr.node*7 + addr.point : 0;
+    if (name_valid)
+        for (const char* p = name; *p; p++)
+            hash = hash*31 + g_tolower(*p);
+
+    ColorNameCache& c = colorname_cache[hash % COLORNAME_CACHE];
+    bool hit = c.used and (c.hasname == name_valid) and (not name_valid or (c.name == name));
+    if (hit)
+        hit = addr_valid ? c.addr.equals(addr) : c.addr.invalid();
+
+    if (not hit)
     {
-        if (addr_valid && addr.match(it->first.addr))
-            return it->second;
-        if (name_valid && gwildmat(name, it->first.name))
-            return it->second;
+        c.used = true;
+        c.hasname = name_valid;
+        c.name = name_valid ? name : "";
+        if (addr_valid)
+            c.addr = addr;
+        else
+            c.addr.reset();
+        c.rule = ColorNameRule(name, addr, addr_valid, name_valid);
     }
 
-    return color;
+    return (c.rule == COLORNAME_NONE) ? color : CFG->colorname[c.rule].second;
 }
 
 
@@ -30,6 +30,7 @@
 
 //  ------------------------------------------------------------------
 
+#include <map>
 #include <vector>
 #include <gecfgg.h>
 #include <gmoarea.h>
@@ -217,6 +218,21 @@ private:
     Desc        alistselections[16];
     byte        mask;
 
+    // GOLDLAST.LST state as loaded, used to skip needless rewrites
+    bool        goldlastvalid;
+    uint        goldlastareas;
+    dword       goldlastsel;
+
+    static void  GoldLastEntry(Area* ap, ggoldlast& entry);
+    static dword GoldLastState(const ggoldlast& entry, Area* ap);
+
+    // Uppercase echoid index used while the areas are configured
+    std::map<std::string, Area*> echoindex;
+    uint        echoindexed;
+
+    Area* EchoIndexFind(const char* echoid);
+    void  EchoIndexReset();
+
     friend class Area;
     friend class SelMaskPick;
 
@@ -298,12 +314,184 @@ public:
 };
 
 
+//  ------------------------------------------------------------------
+//  Snapshot of what each AREAFILE directive imported, so unchanged
+//  areafiles need not be parsed again on the next start
+
+const word CUR_GOLDAREA_VER = 0x0102;
+
+enum
+{
+    AFC_AREA,
+    AFC_ADDRESS,
+    AFC_ORIGIN,
+    AFC_USERNAME,
+    AFC_JAMSMAPIHIGHWATER,
+    AFC_ECHOLIST,
+    AFC_AREADESC,
+    AFC_ADEPTXBBSPATH,
+    AFC_EZYCOMMSGBASE,
+    AFC_EZYCOMUSERBASE,
+    AFC_GOLDBASEPATH,
+    AFC_HUDSONPATH,
+    AFC_JAMPATH,
+    AFC_PCBOARDPATH,
+    AFC_SQUISHUSERPATH,
+    AFC_FIDOLASTREAD,
+    AFC_SETENV
+};
+
+class GAreafileCache
+{
+
+private:
+
+    // Size and time of a file the import depended on
+    struct Stamp
+    {
+        std::string path;
+        long        size;         // -1 if the file did not exist
+        dword       mtime;
+    };
+
+    // Callback made by the areafile reader
+    struct Event
+    {
+        int         code;         // AFC_* constant
+        int         n;            // Index in areas, flag or force value
+        std::string s1;
+        std::string s2;
+        uint        echos;        // Echolist entries added before the call
+        uint        descs;        // Desclist entries added before the call
+    };
+
+    struct Entry
+    {
+        std::string           key;
+        std::vector<Stamp>    stamps;
+        int                   ra2usersbbs;
+        int                   squishuserno;
+        std::vector<Event>    events;
+        std::vector<AreaCfg>  areas;
+        std::vector<EchoList> echos;
+        std::vector<DescList> descs;
+        bool                  used;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::string> journal;
+
+    int  current;                 // Entry being recorded, -1 if none
+    bool nested;                  // Inside a recorded callback
+    bool loaded;
+    bool dirty;
+    uint echostart;
+    uint descstart;
+
+    void Filename(char* file);
+    bool Stale(const Entry& entry);
+    void Sync(const Entry& entry, uint& echos, uint& descs, uint toechos, uint todescs);
+
+    friend class GAreafileEvent;
+
+public:
+
+    GAreafileCache();
+
+    void Load();
+    void Save();
+
+    bool Replay(const std::string& key);
+    void Begin(const std::string& key);
+    void End();
+
+    void Record(int code, const char* s1 = NULL, const char* s2 = NULL, int n = 0);
+    void Record(const AreaCfg& aa);
+};
+
+extern GAreafileCache AFC;
+
+
+//  ------------------------------------------------------------------
+//  Records a callback made while an areafile is being read.
+//  Callbacks made from inside a recorded one are not recorded.
+
+class GAreafileEvent
+{
+
+private:
+
+    bool owner;
+
+    void Enter()
+    {
+        owner = (AFC.current != -1) and not AFC.nested;
+        if(owner)
+            AFC.nested = true;
+    }
+
+public:
+
+    GAreafileEvent(int code, const char* s1 = NULL, const char* s2 = NULL, int n = 0)
+    {
+        if((AFC.current != -1) and not AFC.nested)
+            AFC.Record(code, s1, s2, n);
+        Enter();
+    }
+    GAreafileEvent(const AreaCfg& aa)
+    {
+        if((AFC.current != -1) and not AFC.nested)
+            AFC.Record(aa);
+        Enter();
+    }
+    ~GAreafileEvent()
+    {
+        if(owner)
+            AFC.nested = false;
+    }
+};
+
+
 //  ------------------------------------------------------------------
 //  Msgbase function prototypes
 
 int AreaCmp(const Area** __a, const Area** __b);
 
 
+//  ------------------------------------------------------------------
+//  TWITNAME and TWITSUBJ lists of an area, compiled for matching
+
+struct TwitAddrLess
+{
+    bool operator()(const Addr& a, const Addr& b) const
+    {
+        return a.compare(b) < 0;
+    }
+};
+
+struct TwitFilter
+{
+    bool compiled;
+
+    std::map<std::string, std::vector<int> > names;   // Literal names
+    std::map<Addr, int, TwitAddrLess>        addrs;   // Any name, exact address
+    std::vector<int>                         others;  // Wildcard names and address masks
+
+    std::vector<int> subjs[256];                      // Subjects by first character
+    std::vector<int> subjsany;                        // Subjects checked at every position
+
+    TwitFilter() : compiled(false) {}
+
+    void Reset()
+    {
+        compiled = false;
+    }
+    void Compile(const std::vector<Node>& twitname, const gstrarray& twitsubj);
+    int  MatchName(const std::vector<Node>& twitname, const char* name, const Addr& addr) const;
+    bool MatchSubj(const gstrarray& twitsubj, const char* subj) const;
+};
+
+
 //  ------------------------------------------------------------------
 //  Area data (collected from global/Random System)
 
@@ -456,6 +644,7 @@ struct AreaData
     bool   inittwit;
     std::vector<Node> twitname;
     gstrarray         twitsubj;
+    TwitFilter        twitfilter;
     bool   viewhidden;
     bool   viewkludge;
     bool   viewquote;
@@ -479,6 +668,7 @@ private:
     bool findfirst;
     uint findtype;  //1 - FindAll, 2 - FindHdr
     word marks;     // storing 16 different marks
+    dword goldlast; // GOLDLAST.LST entry checksum at load time
 
     friend class AreaList;
 
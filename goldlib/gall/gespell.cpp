@@ -835,6 +835,8 @@ bool CSpellChecker::Load(const char *langId, const char *userDic)
         return true;
     }
 
+    mCache.clear();
+
     CSpellLangV::iterator it;
     for (it = mLangs.begin(); it != mLangs.end(); it++)
     {
@@ -855,6 +857,8 @@ void CSpellChecker::UnLoad()
 {
     if (!IsLoaded()) return;
 
+    mCache.clear();
+
     CSpellLangV::iterator it;
     for (it = mLangsLoaded.begin(); it != mLangsLoaded.end(); it++)
     {
@@ -877,6 +881,8 @@ void CSpellChecker::UnLoad(const char *langId)
     }
     if (!IsLoaded()) return;
 
+    mCache.clear();
+
     CSpellLangV::iterator it;
     for (it = mLangsLoaded.begin(); it != mLangsLoaded.end(); it++)
     {
@@ -903,16 +909,31 @@ bool CSpellChecker::Check(const char *text)
         return false;
     }
 
+    // The editor checks the same visible words on every repaint
+    CSpellCacheM::iterator cached = mCache.find(text);
+    if (cached != mCache.end())
+    {
+        mText = cached->second.second;
+        return cached->second.first;
+    }
+
+    if (mCache.size() >= 8192)
+        mCache.clear();
+
+    bool result = false;
     CSpellLangV::iterator it;
     for (it = mLangsLoaded.begin(); it != mLangsLoaded.end(); it++)
     {
         mText = (*it)->RecodeText(text, true);
         if ((*it)->SpellCheck(mText.c_str()))
         {
-            return true;
+            result = true;
+            break;
         }
     }
-    return false;
+
+    mCache[text] = std::pair<bool, std::string>(result, mText);
+    return result;
 }
 
 
@@ -966,6 +987,7 @@ bool CSpellChecker::AddWord()
         {
             if ((*it)->GetSpellType() == SCHECKET_TYPE_MSSPELL)
             {
+                mCache.clear();
                 return (*it)->AddWord(mText.c_str());
             }
         }
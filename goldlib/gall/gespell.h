@@ -49,6 +49,8 @@
     #define PATH_MAX _MAX_PATH
 #endif
 
+#include <map>
+
 const uint SCHECKET_TYPE_UNKNOWN = 0;
 const uint SCHECKET_TYPE_MSSPELL = 1;
 const uint SCHECKET_TYPE_MYSPELL = 2;
@@ -316,6 +318,10 @@ private:
     CSpellLangV    mLangs;
     CSpellSuggestV mSuggest;
 
+    // Verdicts and recoded text of checked words, for the loaded languages
+    typedef std::map<std::string, std::pair<bool, std::string> > CSpellCacheM;
+    CSpellCacheM   mCache;
+
 public:
     CSpellChecker();
     ~CSpellChecker()
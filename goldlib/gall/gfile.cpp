@@ -183,6 +183,8 @@ int gfile::Open(const char* __path, int __access, int __shflag, int __mode)
         return -1;
     }
 
+    gfile_journal_add(__path);
+
 #if defined(_tsopen_s)
     status = _tsopen_s(&fh, __path, __access, __shflag, __mode);
     return fh;
@@ -329,6 +331,7 @@ FILE* gfile::Fopen(const char* __path, const char* __mode, int __shflag)
         status = EINVAL;
         return NULL;
     }
+    gfile_journal_add(__path);
     fp = g_fsopen(__path, __mode, __shflag);
     status = (fp == NULL) ? errno : 0;
     if (fp) fh = g_fileno(fp);
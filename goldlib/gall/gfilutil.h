@@ -45,6 +45,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <string>
+#include <vector>
 #include <gshare.h>
 #if !defined(__UNIX__) || defined(__DJGPP__)
     #include <io.h>
@@ -157,6 +158,19 @@ struct Stamp
     #define chdir _chdir2
 #endif
 
+//  ------------------------------------------------------------------
+//  Journal of file names probed or opened.  When set, fexist(),
+//  fsopen() and gfile::Open()/Fopen() append the names they get, so
+//  a caller can later stamp every file a parser depended on.
+
+extern std::vector<std::string>* gfile_journal;
+
+inline void gfile_journal_add(const char* path)
+{
+    if (gfile_journal and path and *path)
+        gfile_journal->push_back(path);
+}
+
 //  Shareable fopen() for compilers that need it
 FILE* fsopen(const char* path, const char* type, int shflag);
 inline FILE* fsopen(const std::string& path, const char* type, int shflag)
@@ -175,11 +189,13 @@ inline bool is_dir(const std::string &path)
 #if defined(_taccess_s)
 inline bool fexist(const TCHAR *filename)
 {
+    gfile_journal_add(filename);
     return *filename ? (0 == (_taccess_s(filename, R_OK)) && !is_dir(filename)) : false;
 }
 #else
 inline bool fexist(const TCHAR *filename)
 {
+    gfile_journal_add(filename);
     return *filename ? (0 == (access(filename, R_OK)) && !is_dir(filename)) : false;
 }
 #endif
@@ -293,6 +293,11 @@ void MakePathname(char* pathname, const char* path, const char* name)
 }
 
 
+//  ------------------------------------------------------------------
+
+std::vector<std::string>* gfile_journal = NULL;
+
+
 //  ------------------------------------------------------------------
 //  Shareable fopen() for compilers that need it
 
@@ -304,6 +309,8 @@ FILE *fsopen(const char *path, const char *type, int shflag)
 
     if( (path == NULL) or (type == NULL) ) return NULL;
 
+    gfile_journal_add(path);
+
     switch(type[0])
     {
     case 'r':
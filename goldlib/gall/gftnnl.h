@@ -104,6 +104,9 @@ public:
     virtual bool        open() = 0;
     virtual void        close() = 0;
 
+    // Release file handles held between lookups, keeping the index open
+    virtual void        release() { }
+
     long                index_max() const
     {
         return indexmax;
@@ -121,6 +124,12 @@ public:
     virtual bool        find(const char* name) = 0;
     virtual bool        find(const ftn_addr& addr) = 0;
 
+    // Position on a name one typo away, if the index can do it
+    virtual bool        find_similar(const char*)
+    {
+        return false;
+    }
+
     bool                find_again()
     {
         return search();
@@ -27,6 +27,7 @@
 //  ------------------------------------------------------------------
 
 #include <gfilutil.h>
+#include <gmemdbg.h>
 #include <gstrall.h>
 #include <gftnnlfd.h>
 #include <stdlib.h>
@@ -161,6 +162,73 @@ void ftn_frontdoor_nodelist_index::getstatus(char* _status, int type) const
 }
 
 
+//  ------------------------------------------------------------------
+//  The private nodelist database is small and searched linearly, so
+//  it is read once and kept in memory while the index is open
+
+void ftn_frontdoor_nodelist_index::loadfdn()
+{
+
+    if(fdnloaded)
+        return;
+    fdnloaded = true;
+
+    int fd = ::sopen(AddPath(nlpath, "FDNODE.FDA"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
+    if(fd == -1)
+        return;
+
+    fdns = filelength(fd) / (long)sizeof(_FDFdn);
+    if(fdns)
+    {
+        fdn = (_FDFdn*)throw_malloc(fdns*sizeof(_FDFdn));
+        long got = read(fd, fdn, fdns*sizeof(_FDFdn));
+        fdns = (got > 0) ? got / (long)sizeof(_FDFdn) : 0;
+    }
+    ::close(fd);
+}
+
+
+//  ------------------------------------------------------------------
+//  Raw nodelist lines are served from a block cache, so browsing
+//  neighbouring entries does not hit the disk for every line
+
+void ftn_frontdoor_nodelist_index::fetchline(int fd, long offset, char* buf)
+{
+
+    const int RAWBLOCK = 4096;
+    const int RAWBACK  = 1024;
+
+    *buf = NUL;
+
+    bool cached = (rawfd == fd) and (offset >= rawpos) and (offset < rawpos+rawlen);
+    if(cached and (offset+255 > rawpos+rawlen) and (rawlen == RAWBLOCK))
+        cached = false;
+
+    if(not cached)
+    {
+        rawfd = fd;
+        rawlen = 0;
+        if(fd == -1)
+            return;
+
+        if(rawblock == NULL)
+            rawblock = (char*)throw_malloc(RAWBLOCK);
+
+        rawpos = (offset > RAWBACK) ? offset-RAWBACK : 0;
+        lseek(fd, rawpos, SEEK_SET);
+        rawlen = read(fd, rawblock, RAWBLOCK);
+        if(rawlen < 0)
+            rawlen = 0;
+        if(offset >= rawpos+rawlen)
+            return;
+    }
+
+    int len = (int)minimum_of_two(255L, rawpos+rawlen-offset);
+    memcpy(buf, rawblock+(offset-rawpos), len);
+    buf[len] = NUL;
+}
+
+
 //  ------------------------------------------------------------------
 
 void ftn_frontdoor_nodelist_index::fetchdata()
@@ -173,12 +241,12 @@ void ftn_frontdoor_nodelist_index::fetchdata()
     if(infdnode)
     {
 
-        int fd = ::sopen(AddPath(nlpath, "FDNODE.FDA"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
-        if(fd != -1)
+        loadfdn();
+        if(fdns)
         {
-            _FDFdn fda;
-            while(read(fd, &fda, sizeof(_FDFdn)) == sizeof(_FDFdn))
+            for(long n=0; n<fdns; n++)
             {
+                const _FDFdn& fda = fdn[n];
                 if(not fda.erased)
                 {
                     if((fda.zone == data.addr.zone) and (fda.net == data.addr.net) and (fda.node == data.addr.node) and (fda.point == data.addr.point))
@@ -274,7 +342,6 @@ void ftn_frontdoor_nodelist_index::fetchdata()
                     }
                 }
             }
-            ::close(fd);
         }
     }
     else
@@ -284,10 +351,7 @@ void ftn_frontdoor_nodelist_index::fetchdata()
         long offset = noderec().nlofs & ~(IN_FDNET|IN_FDPOINT);
 
         char buf[256];
-        buf[255] = NUL;
-
-        lseek(fd, offset, SEEK_SET);
-        read(fd, buf, 255);
+        fetchline(fd, offset, buf);
         if(*buf != ';')
         {
 
@@ -378,8 +442,28 @@ void ftn_frontdoor_nodelist_index::getnodedata()
 void ftn_frontdoor_nodelist_index::getblock()
 {
 
+    _FDCache* victim = NULL;
+    for(int n=0; n<FD_CACHESIZE; n++)
+    {
+        _FDCache* c = &cache[n];
+        if((c->fd == xfd) and (c->blockno == blockno))
+        {
+            c->used = ++cacheuse;
+            memcpy(&block, &c->blk, blocksize);
+            return;
+        }
+        if((victim == NULL) or (c->fd == -1) or ((victim->fd != -1) and (c->used < victim->used)))
+            victim = c;
+    }
+
     lseek(xfd, (long)blockno*(long)blocksize, SEEK_SET);
-    read(xfd, &block, blocksize);
+    if(read(xfd, &block, blocksize) == (int)blocksize)
+    {
+        victim->fd = xfd;
+        victim->blockno = blockno;
+        victim->used = ++cacheuse;
+        memcpy(&victim->blk, &block, blocksize);
+    }
 }
 
 
@@ -415,16 +499,13 @@ bool ftn_frontdoor_nodelist_index::search()
     xfd = namebrowse ? ufd : fdfd;
     blocksize = namebrowse ? sizeof(_FDUdb) : sizeof(_FDFdb);
 
-    // Read beginning control block
-    lseek(xfd, 0L, SEEK_SET);
-    read(xfd, &ctl, sizeof(_FDCtl));
-
-    // Now trace down the tree, starting at the master index
+    // Now trace down the tree, starting at the master index. The
+    // control blocks and file sizes were read by open().
     exactmatch = false;
     int diff = 0;
     int prevdiff = 0;
-    blockno = ctl.hdr.master_idx;
-    maxblockno = (uint)(lseek(xfd, 0L, SEEK_END)/blocksize);
+    blockno = (namebrowse ? uctl : ctl).hdr.master_idx;
+    maxblockno = namebrowse ? udxblocks : fdxblocks;
     depth = 0;
     node = 1;
     push();
@@ -632,6 +713,17 @@ ftn_frontdoor_nodelist_index::ftn_frontdoor_nodelist_index()
     isopen = false;
     blocksize = 0;
     depth = 0;
+    fdxblocks = udxblocks = 0;
+    for(int n=0; n<FD_CACHESIZE; n++)
+        cache[n].fd = -1;
+    cacheuse = 0;
+    fdn = NULL;
+    fdns = 0;
+    fdnloaded = false;
+    rawblock = NULL;
+    rawfd = -1;
+    rawpos = 0;
+    rawlen = 0;
 }
 
 
@@ -666,6 +758,7 @@ bool ftn_frontdoor_nodelist_index::open()
 
     // Read the control block up front
     read(fdfd, &ctl, sizeof(_FDCtl));
+    fdxblocks = (uint)(filelength(fdfd) / sizeof(_FDFdb));
 
     // Now use that info to open the primary nodelist
     Path primary;
@@ -681,6 +774,8 @@ bool ftn_frontdoor_nodelist_index::open()
         close();
         return false;
     }
+    read(ufd, &uctl, sizeof(_FDCtl));
+    udxblocks = (uint)(filelength(ufd) / sizeof(_FDUdb));
 
     // Failing to open the private nodelist is not an error, since there may not be one!
     pfd = ::sopen(AddPath(nlpath, is_intermail ? "IMNET.PVT" : "FDNET.PVT"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
@@ -710,6 +805,18 @@ void ftn_frontdoor_nodelist_index::close()
     if(ufd != -1)   ::close(ufd);
     ufd  = -1;
 
+    for(int n=0; n<FD_CACHESIZE; n++)
+        cache[n].fd = -1;
+    cacheuse = 0;
+
+    throw_release(fdn);
+    fdns = 0;
+    fdnloaded = false;
+
+    throw_release(rawblock);
+    rawfd = -1;
+    rawlen = 0;
+
     isopen = false;
 }
 
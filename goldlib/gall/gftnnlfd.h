@@ -286,6 +286,20 @@ struct _FDstate
 #endif
 
 
+//  ------------------------------------------------------------------
+//  Index block cache
+
+#define FD_CACHESIZE  16    // Blocks kept in the cache
+
+struct _FDCache
+{
+    int    fd;              // Index file handle, -1 if unused
+    uint   blockno;         // Block number in the index file
+    long   used;            // Use counter for LRU replacement
+    _FDBlk blk;             // Cached block
+};
+
+
 //  ------------------------------------------------------------------
 
 class ftn_frontdoor_nodelist_index : public ftn_nodelist_index_base
@@ -301,8 +315,22 @@ class ftn_frontdoor_nodelist_index : public ftn_nodelist_index_base
     int           xfd;
 
     _FDCtl        ctl;
+    _FDCtl        uctl;
+    uint          fdxblocks;
+    uint          udxblocks;
 
     _FDBlk        block;
+    _FDCache      cache[FD_CACHESIZE];
+    long          cacheuse;
+
+    _FDFdn*       fdn;               // FDNODE.FDA, loaded on first use
+    long          fdns;
+    bool          fdnloaded;
+
+    char*         rawblock;          // Block cache for the raw nodelists
+    int           rawfd;
+    long          rawpos;
+    int           rawlen;
     uint          blocksize;
     uint          blockno;
     uint          maxblockno;
@@ -329,6 +357,8 @@ class ftn_frontdoor_nodelist_index : public ftn_nodelist_index_base
     int           addrcmp() const;
     void          getstatus(char* status, int type) const;
     void          fetchdata();
+    void          fetchline(int fd, long offset, char* buf);
+    void          loadfdn();
     void          getnodedata();
     void          push();
     void          pop();
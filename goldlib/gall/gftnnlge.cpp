@@ -85,29 +85,152 @@ static char* make_goldnode_name(char* inp)
 
 //  ------------------------------------------------------------------
 
-void ftn_golded_nodelist_index::fetchdata()
+//  Indexes up to this size are read into memory on open(). Larger ones
+//  are searched on disk, so a full world nodelist does not cost several
+//  megabytes of heap for the whole session.
+
+const long GXLOADMAX = 0x40000L;
+
+static void* load_index(const char* file, long& len, int& fh)
 {
 
-    int currfileno = (int)((current.pos >> 24) & 0xFF);
+    len = 0;
 
-    // currfileno == 0xFF: Entry is taken from a userlist, no nodelist available
-    if(currfileno != lastfileno)
+    fh = ::sopen(file, O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
+    if(fh == -1)
+        return NULL;
+
+    len = filelength(fh);
+    if(len > GXLOADMAX)
+        return NULL;
+
+    void* buf = throw_malloc(len ? len : 1);
+    if(read(fh, buf, len) != len)
     {
-        if(fhx != -1)
-            ::close(fhx);
+        throw_free(buf);
+        buf = NULL;
+        len = 0;
+    }
+    ::close(fh);
+    fh = -1;
 
-        if(currfileno != 0xff)
-        {
-            fhx = ::sopen(nodelist[currfileno].filename, O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
-            lastfileno = currfileno;
-        }
-        else
+    return buf;
+}
+
+
+//  ------------------------------------------------------------------
+//  Returns record n of the address index, that is the name index record
+//  holding the n'th address, or -1 if it cannot be read.
+
+long ftn_golded_nodelist_index::readaddr(long n)
+{
+
+    if(gxa)
+        return index32 ? (long)((dword*)gxa)[n] : (long)((word*)gxa)[n];
+
+    if(fha == -1)
+        fha = ::sopen(AddPath(nlpath, "goldnode.gxa"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
+    if(fha == -1)
+        return -1;
+
+    if(index32)
+    {
+        dword seekto;
+        lseekset(fha, n*(long)sizeof(dword));
+        return (read(fha, &seekto, sizeof(dword)) == sizeof(dword)) ? (long)seekto : -1;
+    }
+
+    word seekto;
+    lseekset(fha, n*(long)sizeof(word));
+    return (read(fha, &seekto, sizeof(word)) == sizeof(word)) ? (long)seekto : -1;
+}
+
+
+//  ------------------------------------------------------------------
+//  Reads record n of the name index
+
+void ftn_golded_nodelist_index::readname(long n, _GEIdx& rec)
+{
+
+    if(gxn)
+    {
+        rec = gxn[n];
+        return;
+    }
+
+    if(fhn == -1)
+        fhn = ::sopen(AddPath(nlpath, "goldnode.gxn"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
+    if(fhn != -1)
+    {
+        lseekset(fhn, n*(long)sizeof(_GEIdx));
+        if(read(fhn, &rec, sizeof(_GEIdx)) == sizeof(_GEIdx))
+            return;
+    }
+    rec.reset();
+}
+
+
+//  ------------------------------------------------------------------
+
+void ftn_golded_nodelist_index::fetchline(char* buf)
+{
+
+    // Raw nodelist lines are served from a block cache, so browsing
+    // neighbouring entries and repeated lookups do not hit the disk
+    const int RAWBLOCK = 4096;
+    const int RAWBACK  = 1024;
+
+    *buf = NUL;
+
+    long pos = current.pos & 0x00FFFFFFL;
+
+    bool cached = (rawfileno == lastfileno) and (pos >= rawpos) and (pos < rawpos+rawlen);
+    if(cached and (pos+255 > rawpos+rawlen) and (rawlen == RAWBLOCK))
+        cached = false;
+
+    if(not cached)
+    {
+        if((fhx != -1) and (rawfileno != lastfileno))
         {
+            ::close(fhx);
             fhx = -1;
-            lastfileno = -1;
         }
+        rawfileno = lastfileno;
+        rawlen = 0;
+
+        if(fhx == -1)
+            fhx = ::sopen(nodelist[lastfileno].filename, O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
+        if(fhx == -1)
+            return;
+
+        if(rawblock == NULL)
+            rawblock = (char*)throw_malloc(RAWBLOCK);
+
+        rawpos = (pos > RAWBACK) ? pos-RAWBACK : 0;
+        lseekset(fhx, rawpos);
+        rawlen = read(fhx, rawblock, RAWBLOCK);
+        if(rawlen < 0)
+            rawlen = 0;
+        if(pos >= rawpos+rawlen)
+            return;
     }
 
+    int len = (int)minimum_of_two(255L, rawpos+rawlen-pos);
+    memcpy(buf, rawblock+(pos-rawpos), len);
+    buf[len] = NUL;
+}
+
+
+//  ------------------------------------------------------------------
+
+void ftn_golded_nodelist_index::fetchdata()
+{
+
+    int currfileno = (int)((current.pos >> 24) & 0xFF);
+
+    // currfileno == 0xFF: Entry is taken from a userlist, no nodelist available
+    lastfileno = ((currfileno != 0xff) and (currfileno < nodelists)) ? currfileno : -1;
+
     strunrevname(data.name, current.name);
     *data.status = NUL;
     *data.system = NUL;
@@ -116,22 +239,13 @@ void ftn_golded_nodelist_index::fetchdata()
     *data.flags = NUL;
     *data.baud = NUL;
 
-    if(fhx != -1)
+    if(lastfileno != -1)
     {
 
         char buf[256];
-        buf[255] = NUL;
-
-        lseekset(fhx, current.pos & 0x00FFFFFFL);
-        read(fhx, buf, 255);
-        if(*buf != ';')
+        fetchline(buf);
+        if(*buf and (*buf != ';'))
         {
-
-            /*
-                  char* end = strchr(buf, '\r');
-                  if(end)
-                    *end = NUL;
-            */
             strtok(buf,"\r\n");
 
             data.unpack(buf);
@@ -155,23 +269,15 @@ void ftn_golded_nodelist_index::getnode()
     long seekto = node - 1L;
     if(not namebrowse)
     {
-        if(index32)
-        {
-            lseekset(fha, seekto*(long)sizeof(dword));
-            dword nseekto;
-            read(fha, &nseekto, sizeof(dword));
-            seekto = nseekto;
-        }
+        if((seekto < 0) or (seekto >= maxnode))
+            seekto = -1;
         else
-        {
-            lseekset(fha, seekto*(long)sizeof(word));
-            word nseekto;
-            read(fha, &nseekto, sizeof(word));
-            seekto = nseekto;
-        }
+            seekto = readaddr(seekto);
     }
-    lseekset(fhn, seekto*(long)sizeof(_GEIdx));
-    read(fhn, &current, sizeof(_GEIdx));
+    if((seekto >= 0) and (seekto < gxnrecs))
+        readname(seekto, current);
+    else
+        current.reset();
 }
 
 
@@ -323,10 +429,20 @@ bool ftn_golded_nodelist_index::search()
 ftn_golded_nodelist_index::ftn_golded_nodelist_index()
 {
 
-    fha = fhn = fhx = -1;
+    fhx = -1;
+    gxa = NULL;
+    gxn = NULL;
+    fha = -1;
+    fhn = -1;
+    gxnrecs = 0;
+    rawblock = NULL;
+    rawfileno = -1;
+    rawpos = 0;
+    rawlen = 0;
     nodelist = NULL;
     nodelists = 0;
     lastfileno = -1;
+    maxnode = 0;
     isopen = false;
 }
 
@@ -349,19 +465,24 @@ bool ftn_golded_nodelist_index::open()
     if(isopen)
         close();
 
-    fha = ::sopen(AddPath(nlpath, "goldnode.gxa"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
-    if(fha == -1)
+    // Small indexes are read in one go and searched in memory,
+    // large ones are left open and read per probe
+    long galen;
+    gxa = (byte*)load_index(AddPath(nlpath, "goldnode.gxa"), galen, fha);
+    if((gxa == NULL) and (fha == -1))
     {
         close();
         return false;
     }
 
-    fhn = ::sopen(AddPath(nlpath, "goldnode.gxn"), O_RDONLY|O_BINARY, SH_DENYNO, S_STDRD);
-    if(fhn == -1)
+    long gnlen;
+    gxn = (_GEIdx*)load_index(AddPath(nlpath, "goldnode.gxn"), gnlen, fhn);
+    if((gxn == NULL) and (fhn == -1))
     {
         close();
         return false;
     }
+    gxnrecs = gnlen / (long)sizeof(_GEIdx);
 
     FILE* fp = fopen(AddPath(nlpath, "goldnode.gxl"), "rt");
     if(fp == NULL)
@@ -386,10 +507,10 @@ bool ftn_golded_nodelist_index::open()
     }
     fclose(fp);
 
-    maxnode = filelength(fha) / sizeof(word);
-    if(filelength(fhn) / sizeof(_GEIdx) < (size_t)maxnode)
+    maxnode = galen / (long)sizeof(word);
+    if(gxnrecs < maxnode)
     {
-        maxnode = filelength(fha) / sizeof(dword);
+        maxnode = galen / (long)sizeof(dword);
         index32 = true;
     }
     else
@@ -411,17 +532,34 @@ void ftn_golded_nodelist_index::close()
 
     lastfileno = -1;
 
-    if(fha != -1)  ::close(fha);
-    fha = -1;
-    if(fhn != -1)  ::close(fhn);
-    fhn = -1;
-    if(fhx != -1)  ::close(fhx);
-    fhx = -1;
+    throw_release(gxa);
+    throw_release(gxn);
+    gxnrecs = 0;
+    maxnode = 0;
+
+    throw_release(rawblock);
+    rawfileno = -1;
+    rawlen = 0;
+
+    release();
 
     isopen = false;
 }
 
 
+//  ------------------------------------------------------------------
+
+void ftn_golded_nodelist_index::release()
+{
+
+    // Index files that were not loaded are reopened on the next probe
+    if(fhx != -1)  ::close(fhx);
+    if(fha != -1)  ::close(fha);
+    if(fhn != -1)  ::close(fhn);
+    fhx = fha = fhn = -1;
+}
+
+
 //  ------------------------------------------------------------------
 
 bool ftn_golded_nodelist_index::find(const char* lookup_name)
@@ -444,6 +582,143 @@ bool ftn_golded_nodelist_index::find(const ftn_addr& addr)
 }
 
 
+//  ------------------------------------------------------------------
+//  Returns the first record in the name index not below name
+
+long ftn_golded_nodelist_index::lowername(const char* name)
+{
+
+    long left = 0;
+    long right = gxnrecs;
+    _GEIdx rec;
+
+    while(left < right)
+    {
+        long mid = (left+right)/2;
+        readname(mid, rec);
+        if(stricmp(rec.name, name) < 0)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+
+    return left;
+}
+
+
+//  ------------------------------------------------------------------
+//  Returns true if name is in the index. Otherwise best is set to the
+//  first name starting with it, unless an earlier candidate had one.
+
+bool ftn_golded_nodelist_index::similar(const char* name, long& best)
+{
+
+    long n = lowername(name);
+    if(n < gxnrecs)
+    {
+        _GEIdx rec;
+        readname(n, rec);
+        if(stricmp(rec.name, name) == 0)
+        {
+            best = n;
+            return true;
+        }
+        if((best == -1) and (strnicmp(rec.name, name, strlen(name)) == 0))
+            best = n;
+    }
+
+    return false;
+}
+
+
+//  ------------------------------------------------------------------
+//  The name index is sorted, so it serves as a trie over all names:
+//  every single-character deletion, transposition, substitution and
+//  insertion of the name is looked up as a prefix, as is the name with
+//  first and last name swapped.
+
+bool ftn_golded_nodelist_index::find_similar(const char* lookup_name)
+{
+
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ,.-'";
+
+    namebrowse = true;
+
+    char name[80];
+    make_goldnode_name(strxcpy(name, lookup_name, sizeof(name)-1));
+    int len = strlen(name);
+    if((len == 0) or (gxnrecs == 0))
+        return false;
+
+    // Nothing to suggest when the name itself is found
+    long best = -1;
+    similar(name, best);
+    if(best != -1)
+        return false;
+
+    char cand[82];
+    bool exact = false;
+
+    // Last name entered first
+    const char* p = strskip_wht(lookup_name);
+    const char* q = strpbrk(p, " _");
+    if(q)
+    {
+        strxcpy(cand, p, minimum_of_two((size_t)(q-p+1), sizeof(cand)-2));
+        strcat(cand, ", ");
+        strxcat(cand, strskip_wht(q+1), sizeof(cand));
+        strbtrim(cand);
+        exact = similar(cand, best);
+    }
+
+    for(int i=0; (i <= len) and not exact; i++)
+    {
+        if(i < len)
+        {
+            strcpy(cand, name);
+            memmove(cand+i, cand+i+1, len-i);
+            if((exact = similar(cand, best)) == true)
+                break;
+        }
+        if(i+1 < len)
+        {
+            strcpy(cand, name);
+            char c = cand[i];
+            cand[i] = cand[i+1];
+            cand[i+1] = c;
+            if((exact = similar(cand, best)) == true)
+                break;
+        }
+        for(const char* c = alphabet; *c and not exact; c++)
+        {
+            if((i < len) and (g_tolower(name[i]) != *c))
+            {
+                strcpy(cand, name);
+                cand[i] = *c;
+                exact = similar(cand, best);
+            }
+            if(not exact)
+            {
+                memcpy(cand, name, i);
+                cand[i] = *c;
+                strcpy(cand+i+1, name+i);
+                exact = similar(cand, best);
+            }
+        }
+    }
+
+    if(best == -1)
+        return false;
+
+    node = best + 1;
+    getnode();
+    strcpy(searchname, current.name);
+    fetchdata();
+    exactmatch = false;
+    return true;
+}
+
+
 //  ------------------------------------------------------------------
 
 bool ftn_golded_nodelist_index::previous()
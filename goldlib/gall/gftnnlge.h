@@ -75,11 +75,20 @@ protected:
         long stamp;
     };
 
-    int      fha;
-    int      fhn;
     int      fhx;
     bool     index32;            // New (32-bit) address index used?
 
+    byte*    gxa;                // Address index, if small enough to load
+    _GEIdx*  gxn;                // Name index, if small enough to load
+    int      fha;                // Address index handle, if not loaded
+    int      fhn;                // Name index handle, if not loaded
+    long     gxnrecs;            // Records in the name index
+
+    char*    rawblock;           // Block cache for the raw nodelists
+    int      rawfileno;          // File number of the cached block
+    long     rawpos;             // Offset of the cached block
+    int      rawlen;             // Bytes in the cached block
+
     fstamp*  nodelist;
     int      nodelists;
 
@@ -95,7 +104,11 @@ protected:
     char     searchname[80];
     ftn_addr searchaddr;
 
+    long     readaddr(long n);
+    void     readname(long n, _GEIdx& rec);
+
     void     fetchdata();
+    void     fetchline(char* buf);
     void     getnode();
     int      namecmp() const;
     int      addrcmp() const;
@@ -106,6 +119,9 @@ protected:
     bool     searchfirst();
     bool     search();
 
+    long     lowername(const char* name);
+    bool     similar(const char* name, long& best);
+
 public:
 
     ftn_golded_nodelist_index();
@@ -122,9 +138,11 @@ public:
 
     bool open();
     void close();
+    void release();
 
     bool find(const char* name);
     bool find(const ftn_addr& addr);
+    bool find_similar(const char* name);
 
     bool previous();
     bool next();
@@ -191,10 +191,15 @@ void ftn_version7_nodelist_index::fetchdata()
     if(node)
     {
 
-        // Get data package
-        _V7Data v7data;
+        // Get data package, phone, password and packed data in one read
+        char rec[sizeof(_V7Data)+3*256];
+        memset(rec, 0, sizeof(rec));
         lseek(dfh, block.ndx.lnodeblk.leafref[node-1].keyval, SEEK_SET);
-        read(dfh, &v7data, sizeof(_V7Data));
+        read(dfh, rec, sizeof(rec));
+
+        _V7Data v7data;
+        memcpy(&v7data, rec, sizeof(_V7Data));
+        char* recp = rec + sizeof(_V7Data);
 
         // Reset data buffers
         char buf[160], buf2[1024];
@@ -202,14 +207,15 @@ void ftn_version7_nodelist_index::fetchdata()
         memset(buf2, 0, sizeof(buf2));
 
         // Get phone
-        read(dfh, data.phone, v7data.phone_len);
+        memcpy(data.phone, recp, v7data.phone_len);
         data.phone[v7data.phone_len] = NUL;
+        recp += v7data.phone_len;
 
         // Skip password
-        lseek(dfh, v7data.password_len, SEEK_CUR);
+        recp += v7data.password_len;
 
         // Get packed data and unpack it
-        read(dfh, buf2, v7data.pack_len);
+        memcpy(buf2, recp, v7data.pack_len);
         v7unpack(buf2, buf, v7data.pack_len);
 
         // Get system name
@@ -247,21 +253,26 @@ void ftn_version7_nodelist_index::fetchdata()
         if(use_v7plus)
         {
 
-            lseek(tfh, v7p, SEEK_SET);
-
             if(v7data.nodeflags & V7_B_Point)  // node is a point
-                lseek(tfh, (long)dtpctl.AllFixSize, SEEK_CUR);
+                v7p += dtpctl.AllFixSize;
             else
-                lseek(tfh, (long)dtpctl.AllFixSize + (long)dtpctl.AddFixSize, SEEK_CUR);
+                v7p += dtpctl.AllFixSize + dtpctl.AddFixSize;
 
-            word raw_length;
-
-            read(tfh, &raw_length, sizeof(raw_length));
+            // Get length and raw data in one read
+            char dtp[sizeof(word)+sizeof(buf2)];
+            lseek(tfh, v7p, SEEK_SET);
+            int got = read(tfh, dtp, sizeof(dtp));
 
-            if(raw_length < sizeof(buf2))
+            if(got >= (int)sizeof(word))
             {
-                read(tfh, buf2, raw_length);
-                data.unpack(buf2);
+                word raw_length;
+                memcpy(&raw_length, dtp, sizeof(word));
+
+                if(raw_length < sizeof(buf2))
+                {
+                    memcpy(buf2, dtp+sizeof(word), minimum_of_two((int)raw_length, got-(int)sizeof(word)));
+                    data.unpack(buf2);
+                }
             }
         }
         else
@@ -344,11 +355,87 @@ void ftn_version7_nodelist_index::getleafkey()
 
 //  ------------------------------------------------------------------
 
-void ftn_version7_nodelist_index::getblock()
+_V7Cache* ftn_version7_nodelist_index::cacheslot()
+{
+
+    // Index nodes, the root and the control record are kept in
+    // preference to leaves, which are replaced first
+    _V7Cache* victim = NULL;
+    _V7Cache* pinned = NULL;
+    for(int n=0; n<V7_CACHESIZE; n++)
+    {
+        _V7Cache* c = &cache[n];
+        if(c->fh == -1)
+            return c;
+        if(c->blk.ndx.inodeblk.indxfirst != -1)
+        {
+            if((pinned == NULL) or (c->used < pinned->used))
+                pinned = c;
+        }
+        else if((victim == NULL) or (c->used < victim->used))
+            victim = c;
+    }
+
+    return victim ? victim : pinned;
+}
+
+
+//  ------------------------------------------------------------------
+
+void ftn_version7_nodelist_index::getblock(int ahead)
 {
 
-    lseek(xfh, blockno*(long)ctl.ndx.ctlblk.ctlblksize, SEEK_SET);
-    read(xfh, &block, sizeof(_V7Ndx));
+    for(int n=0; n<V7_CACHESIZE; n++)
+    {
+        if((cache[n].fh == xfh) and (cache[n].blockno == blockno))
+        {
+            cache[n].used = ++cacheuse;
+            memcpy(&block, &cache[n].blk, sizeof(_V7Ndx));
+            return;
+        }
+    }
+
+    // When browsing, neighbouring leaves are read in the same go
+    long blksize = ctl.ndx.ctlblk.ctlblksize;
+    if((blksize != (long)sizeof(_V7Ndx)) or (blockno < 1))
+        ahead = 0;
+    long firstno = blockno;
+    if(ahead < 0)
+        firstno = maximum_of_two(1L, blockno+ahead);
+    int count = (int)(blockno-firstno) + (ahead > 0 ? ahead : 0) + 1;
+
+    _V7Ndx buf[V7_READAHEAD+1];
+    lseek(xfh, firstno*blksize, SEEK_SET);
+    long got = read(xfh, buf, count*sizeof(_V7Ndx));
+
+    _V7Cache* target = NULL;
+    for(int i=0; i<count; i++)
+    {
+        long have = got - i*(long)sizeof(_V7Ndx);
+        if(have <= 0)
+            break;
+        long no = firstno + i;
+        if(no == blockno)
+            memcpy(&block, &buf[i], minimum_of_two(have, (long)sizeof(_V7Ndx)));
+        if(have < (long)sizeof(_V7Ndx))
+            break;
+
+        bool cached = false;
+        for(int n=0; (n<V7_CACHESIZE) and not cached; n++)
+            cached = (cache[n].fh == xfh) and (cache[n].blockno == no);
+        if(not cached)
+        {
+            _V7Cache* c = cacheslot();
+            c->fh = xfh;
+            c->blockno = no;
+            c->used = ++cacheuse;
+            memcpy(&c->blk, &buf[i], sizeof(_V7Ndx));
+            if(no == blockno)
+                target = c;
+        }
+    }
+    if(target)
+        target->used = ++cacheuse;
 
 #ifdef DEBUG
     if(block.ndx.inodeblk.indxfirst != -1)
@@ -393,8 +480,9 @@ bool ftn_version7_nodelist_index::search()
     node = 0;
 
     // Get CtlRec
-    lseek(xfh, 0, SEEK_SET);
-    read(xfh, &ctl, sizeof(_V7Ndx));
+    blockno = 0;
+    getblock();
+    memcpy(&ctl, &block, sizeof(_V7Ndx));
 
     // The guts of the matter -- walk from CtlRec to Leaf
     blockno = ctl.ndx.ctlblk.ctlroot;
@@ -531,7 +619,7 @@ bool ftn_version7_nodelist_index::prevnode()
         if(block.ndx.lnodeblk.indxblink == 0)
             return false;
         blockno = block.ndx.inodeblk.indxblink;
-        getblock();
+        getblock(-V7_READAHEAD);
         getleaf();
         node = block.ndx.lnodeblk.indxcnt;
     }
@@ -556,7 +644,7 @@ bool ftn_version7_nodelist_index::nextnode()
         if(block.ndx.lnodeblk.indxflink == 0)
             return false;
         blockno = block.ndx.inodeblk.indxflink;
-        getblock();
+        getblock(V7_READAHEAD);
         getleaf();
         node = 1;
     }
@@ -578,6 +666,9 @@ ftn_version7_nodelist_index::ftn_version7_nodelist_index()
     nfh = sfh = dfh = tfh = -1;
     use_v7plus = false;
     isopen = false;
+    for(int n=0; n<V7_CACHESIZE; n++)
+        cache[n].fh = -1;
+    cacheuse = 0;
 }
 
 
@@ -636,6 +727,10 @@ void ftn_version7_nodelist_index::close()
     if(tfh != -1)  ::close(tfh);
     tfh = -1;
 
+    for(int n=0; n<V7_CACHESIZE; n++)
+        cache[n].fh = -1;
+    cacheuse = 0;
+
     isopen = false;
 }
 
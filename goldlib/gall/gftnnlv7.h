@@ -218,6 +218,21 @@ struct _V7DTPCtl
 #endif
 
 
+//  ------------------------------------------------------------------
+//  Index block cache
+
+#define V7_CACHESIZE  32    // Blocks kept in the cache
+#define V7_READAHEAD  4     // Extra leaf blocks read while browsing
+
+struct _V7Cache
+{
+    int    fh;              // Index file handle, -1 if unused
+    long   blockno;         // Block number in the index file
+    long   used;            // Use counter for LRU replacement
+    _V7Ndx blk;             // Cached block
+};
+
+
 //  ------------------------------------------------------------------
 
 class ftn_version7_nodelist_index : public ftn_nodelist_index_base
@@ -229,6 +244,9 @@ class ftn_version7_nodelist_index : public ftn_nodelist_index_base
     int       xfh;
     int       tfh;
 
+    _V7Cache  cache[V7_CACHESIZE];
+    long      cacheuse;
+
     _V7Ndx    ctl;
     _V7Ndx    block;
     _V7DTPCtl dtpctl;
@@ -248,7 +266,8 @@ class ftn_version7_nodelist_index : public ftn_nodelist_index_base
 
     void      getindexkey();
     void      getleafkey();
-    void      getblock();
+    void      getblock(int ahead=0);
+    _V7Cache* cacheslot();
     void      getleaf();
 
     const char*     namekey() const;
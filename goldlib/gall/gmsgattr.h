@@ -153,6 +153,21 @@ public:
 
     bool equals(const ftn_attr& b) const;
 
+    // Raw attribute words, for storing the attributes as numbers
+    uint32_t word1() const
+    {
+        return attr1;
+    }
+    uint32_t word2() const
+    {
+        return attr2;
+    }
+    void set_words(uint32_t w1, uint32_t w2)
+    {
+        attr1 = w1;
+        attr2 = w2;
+    }
+
     ftn_attr& operator=(const char* s)
     {
         get(s);
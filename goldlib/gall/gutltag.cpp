@@ -333,6 +333,33 @@ void GTag::Load(gfile& fp)
 }
 
 
+//  ------------------------------------------------------------------
+//  Load tags from a memory buffer in the same layout as Save() writes.
+//  Returns pointer past the loaded data, or NULL if buffer is short.
+
+const byte* GTag::Load(const byte* __buf, const byte* __end)
+{
+    dword val;
+
+    if ((__end - __buf) < (long)sizeof(dword))
+        return NULL;
+    memcpy(&val, __buf, sizeof(dword));
+    __buf += sizeof(dword);
+
+    if ((dword)(__end - __buf) / sizeof(uint32_t) < val)
+        return NULL;
+
+    count = (uint) val;
+    if (count)
+    {
+        Resize(count);
+        memcpy(tag, __buf, count*sizeof(uint32_t));
+        __buf += count*sizeof(uint32_t);
+    }
+    return __buf;
+}
+
+
 //  ------------------------------------------------------------------
 
 void GTag::Save(gfile& fp)
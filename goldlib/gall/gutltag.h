@@ -132,6 +132,7 @@ public:
     }
 
     void Load(gfile& fp);
+    const byte* Load(const byte* __buf, const byte* __end);
     void Save(gfile& fp);
 
     //  ----------------------------------------------------------------
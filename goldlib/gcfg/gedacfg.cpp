@@ -177,6 +177,8 @@ EchoListClass::EchoListClass()
     descs = 0;
     echolist = NULL;
     desclist = NULL;
+    echosindexed = 0;
+    descsindexed = 0;
 }
 
 
@@ -202,9 +204,44 @@ void EchoListClass::FreeAll()
     echos = 0;
 
     for(n=0; n<descs; n++)
-        throw_release(echolist[n]);
+        throw_release(desclist[n]);
     throw_xrelease(desclist);
     descs = 0;
+
+    echoindex.clear();
+    descindex.clear();
+    echosindexed = 0;
+    descsindexed = 0;
+}
+
+
+//  ------------------------------------------------------------------
+//  Make a case insensitive lookup key
+
+static std::string EchoListKey(const char* str)
+{
+
+    std::string key(str);
+    strupr(key);
+    return key;
+}
+
+
+//  ------------------------------------------------------------------
+//  Add the entries appended since the last lookup to the indexes
+
+void EchoListClass::IndexEchos()
+{
+
+    for(; echosindexed<echos; echosindexed++)
+        echoindex.insert(std::pair<std::string, int>(EchoListKey(echolist[echosindexed]->path), echosindexed));
+}
+
+void EchoListClass::IndexDescs()
+{
+
+    for(; descsindexed<descs; descsindexed++)
+        descindex.insert(std::pair<std::string, int>(EchoListKey(desclist[descsindexed]->echoid), descsindexed));
 }
 
 
@@ -229,6 +266,9 @@ void EchoListClass::SortEchos()
 
     if(echolist)
         qsort(echolist, echos, sizeof(EchoList*), (StdCmpCP)CmpEchos);
+
+    echoindex.clear();
+    echosindexed = 0;
 }
 
 
@@ -252,13 +292,12 @@ int EchoListClass::FindDesc(char* echoid, char** desc)
 
     if(desclist)
     {
-        for(int n=0; n<descs; n++)
+        IndexDescs();
+        std::map<std::string, int>::iterator it = descindex.find(EchoListKey(echoid));
+        if(it != descindex.end())
         {
-            if(strieql(desclist[n]->echoid, echoid))
-            {
-                *desc = desclist[n]->desc;
-                return 1;
-            }
+            *desc = desclist[it->second]->desc;
+            return 1;
         }
     }
     return 0;
@@ -303,24 +342,19 @@ void EchoListClass::AddEcho(char* echoid, char* path, char* desc)
 int EchoListClass::FindEcho(char* echoid, char* path, char* desc)
 {
 
-    EchoList echokey;
-    EchoList* eptr;
-    EchoList* iptr=&echokey;
-
     if(echos)
     {
-        memset(iptr, 0, sizeof(EchoList));
-        strxcpy(echokey.path, path, sizeof(Path));
-        for(int n=0; n<echos; n++)
+        Path key;
+        strxcpy(key, path, sizeof(Path));
+        IndexEchos();
+        std::map<std::string, int>::iterator it = echoindex.find(EchoListKey(key));
+        if(it != echoindex.end())    // Found it
         {
-            eptr = echolist[n];
-            if(CmpEchos((const EchoList**)&iptr, (const EchoList**)&eptr) == 0)    // Found it
-            {
-                strcpy(echoid, eptr->echoid);
-                if(strblank(desc))
-                    strcpy(desc, eptr->desc);
-                return(1);
-            }
+            EchoList* eptr = echolist[it->second];
+            strcpy(echoid, eptr->echoid);
+            if(strblank(desc))
+                strcpy(desc, eptr->desc);
+            return(1);
         }
     }
     return 0;
@@ -343,6 +377,36 @@ int EchoListClass::GetEcho(int n, char** echoid, char** path, char** desc)
 }
 
 
+//  ------------------------------------------------------------------
+
+int EchoListClass::GetDesc(int n, char** echoid, char** desc)
+{
+
+    if(descs)
+    {
+        *echoid = desclist[n]->echoid;
+        *desc = desclist[n]->desc;
+        return(1);
+    }
+    return(0);
+}
+
+
+//  ------------------------------------------------------------------
+//  Add an entry as is, without path mapping or description lookup
+
+void EchoListClass::AppendEcho(const char* echoid, const char* path, const char* desc)
+{
+
+    echolist = (EchoList**)throw_reallox(echolist, (echos+1), sizeof(EchoList*), 50);
+    echolist[echos] = (EchoList*)throw_calloc(1, sizeof(EchoList));
+    strxcpy(echolist[echos]->echoid, echoid, sizeof(Echo));
+    strxcpy(echolist[echos]->path, path, sizeof(Path));
+    strxcpy(echolist[echos]->desc, desc, sizeof(Desc));
+    echos++;
+}
+
+
 //  ------------------------------------------------------------------
 //  Read AREAS.BBS (any flavor!) and store echoid, path and desc.
 
@@ -33,6 +33,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include <string>
 #include <gftnall.h>
 #include <gfile.h>
@@ -184,6 +185,15 @@ private:
     int echos;
     int descs;
 
+    // Lookup indexes, first entry with a given key wins
+    std::map<std::string, int> echoindex;   // Uppercase path
+    std::map<std::string, int> descindex;   // Uppercase echoid
+    int echosindexed;
+    int descsindexed;
+
+    void IndexEchos();
+    void IndexDescs();
+
 public:
 
     EchoListClass();
@@ -194,12 +204,18 @@ public:
     {
         return(echos);
     }
+    int  Descs()
+    {
+        return(descs);
+    }
     void SortEchos();
     void AddDesc(char* echoid, char* desc);
     int  FindDesc(char* echoid, char** desc);
     void AddEcho(char* echoid, char* path, char* desc);
     int  FindEcho(char* echoid, char* path, char* desc);
     int  GetEcho(int n, char** echoid, char** path, char** desc);
+    int  GetDesc(int n, char** echoid, char** desc);
+    void AppendEcho(const char* echoid, const char* path, const char* desc);
 };
 
 
@@ -258,7 +274,7 @@ protected:
 #endif
 #ifndef GCFG_NOFIDOCONF
     AreaCfg echoareadefaults;
-    bool ReadHPTLine(gfile &f, std::string& str);
+    char* ReadHPTLine(char*& ptr);
     void ReadHPTFile(char* path, char* file, char* origin, int group);
 #endif
 #ifndef GCFG_NOIMAIL
@@ -447,6 +463,7 @@ void CfgUsername(char* value);
 void CfgJAMSMAPIHighwater(bool value);
 void ReadEcholist(char* value);
 void SetAreaDesc(char* echoid, char* desc);
+void SetEnviron(const char* value);
 
 void CfgAdeptxbbspath(const char *path, bool force = false);
 void CfgEzycommsgbase(const char *path, bool force = false);
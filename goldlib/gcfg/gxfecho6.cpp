@@ -207,6 +207,7 @@ void gareafile::ReadFastecho(char* tag)
         strcat(file, "fastecho.cfg");
     }
 
+    gfile_journal_add(file);
     fh = sopen(file, O_RDONLY|O_BINARY, sharemode, S_STDRD);
     if (fh != -1)
     {
@@ -26,6 +26,7 @@
 
 #include <cstdlib>
 #include <cerrno>
+#include <vector>
 #include <gcrcall.h>
 #include <gstrall.h>
 #include <gmemdbg.h>
@@ -41,54 +42,51 @@
 
 static char comment_char = '#';
 
+// Files being read, outermost first
+static std::vector<std::string> hpt_includes;
+
 //  ------------------------------------------------------------------
 
-bool gareafile::ReadHPTLine(gfile &f, std::string& str)
-{
-    char buf[1024];
+//  Get the next line from the file buffer, stripped from comments
+//  and surrounding whitespace. Returns NULL at the end of the buffer.
 
-    if (!f.Fgets(buf, ARRAYSIZE(buf)))
-        return false; // eof
+char* gareafile::ReadHPTLine(char*& ptr)
+{
 
-    str = buf;
+    if(not *ptr)
+        return NULL; // eof
 
-    if (!str.empty() && (*(str.end() - 1) != '\n'))
+    char* line = ptr;
+    char* end = strchr(ptr, '\n');
+    if(end)
     {
-        while (f.Fgets(buf, ARRAYSIZE(buf)))
-        {
-            str += buf;
-            if (*(str.end() - 1) == '\n')
-                break;
-        }
+        *end = NUL;
+        ptr = end + 1;
     }
+    else
+        ptr += strlen(ptr);
 
-    std::string::iterator ptr = str.begin();
-    std::string::iterator end = str.end();
     bool state = false;
 
     // state 0: normal state
     //       1: between ""
-    //       2: end
-    //       3: whitespace
-    for (; ptr != end; ptr++)
+    for(char* p = line; *p; p++)
     {
-        if (comment_char == *ptr)
+        if(comment_char == *p)
         {
-            if (!state)
+            if(not state)
             {
-                str.erase(ptr, end);
+                *p = NUL;
                 break;
             }
         }
-        else if ('\"' == *ptr)
+        else if('\"' == *p)
         {
-            state = !state;
+            state = not state;
         }
     }
 
-    strltrim(strtrim(str));
-
-    return true;
+    return strskip_wht(strtrim(line));
 }
 
 
@@ -178,39 +176,53 @@ void gareafile::ReadHPTFile(char* path, char* file, char* origin, int group)
     AreaCfg aa;
     Path buf2;
 
+    // Don't follow include loops
+    std::vector<std::string>::iterator inc;
+    for(inc = hpt_includes.begin(); inc != hpt_includes.end(); inc++)
+    {
+        if(*inc == file)
+        {
+            STD_PRINTNL("* Warning: Recursive include of " << file << " - Skipping.");
+            return;
+        }
+    }
+
     gfile fp(file, "rb", sharemode);
     if (fp.isopen())
     {
-        fp.SetvBuf(NULL, _IOFBF, 8192);
-
         if (not quiet)
             STD_PRINTNL("* Reading " << file);
 
+        // Read the whole file at once and parse it in place
+        long len = fp.FileLength();
+        char* filebuf = (char*)throw_malloc(len+1);
+        if((len > 0) and (fp.Fread(filebuf, len) != 1))
+            len = 0;
+        filebuf[len] = NUL;
+        fp.Fclose();
+
+        hpt_includes.push_back(file);
+
         aa.reset();
         aa.type = GMB_NONE;
         aa.basetype = fidomsgtype;
         aa.groupid = group;
 
-        std::string s;
-        while (ReadHPTLine(fp, s))
+        char* bufptr = filebuf;
+        char* ptr;
+        while ((ptr = ReadHPTLine(bufptr)) != NULL)
         {
-            if (not s.empty())
+            if (*ptr)
             {
-                char *alptr = throw_xstrdup(s.c_str());
-                char *ptr = alptr;
-
                 char* key;
                 char* val = ptr;
-                char* memory = NULL;
                 gettok(&key, &val);
                 switch (strCrc16(key))
                 {
                 case CRC_SET:
                     if (strchg(val, '[', '%') != 0)
                         strchg(val, ']', '%');
-                    memory = static_cast<char*>(malloc(strlen(val)));
-                    strcpy(memory, val);
-                    putenv(memory);
+                    SetEnviron(val);
                     break;
 
                 case CRC_VERSION:
@@ -220,7 +232,6 @@ void gareafile::ReadHPTFile(char* path, char* file, char* origin, int group)
                     if (((ver_maj << 16) + ver_min) > 0x00010009)
                     {
                         STD_PRINTNL("* Error: Unknown fidoconfig version " << ver_maj << '.' << ver_min << " - Skipping.");
-                        throw_xfree(alptr);
                         goto skip_config;
                     }
                 }
@@ -375,12 +386,12 @@ void gareafile::ReadHPTFile(char* path, char* file, char* origin, int group)
 
                     aa.reset();
                 }
-                throw_xfree(alptr);
             }
         }
 
 skip_config:
-        ;
+        hpt_includes.pop_back();
+        throw_free(filebuf);
     }
     else
     {
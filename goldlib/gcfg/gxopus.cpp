@@ -135,8 +135,11 @@ void gareafile::ReadOpus(char* tag)
     else
     {
 
-        // Try for the old 1.1x files
+        // Try for the old 1.1x files.  The directory is journaled too,
+        // since adding or removing a system file changes its time.
 
+        std::string opdir = oppath;
+        gfile_journal_add(StripBackslash(opdir).c_str());
         gposixdir d(oppath);
         const gdirentry *de;
         if(d.ok)
@@ -78,6 +78,7 @@ void gareafile::ReadWMail(char* tag)
         strcpy(path, areapath);
 
     sprintf(file, "%swmail.prm", path);
+    gfile_journal_add(file);
     fh = sopen(file, O_RDONLY|O_BINARY, sharemode, S_STDRD);
     if (fh != -1)
     {
@@ -135,6 +136,7 @@ void gareafile::ReadWMail(char* tag)
     }
 
     sprintf(file, "%sareas.prm", path);
+    gfile_journal_add(file);
     fh = sopen(file, O_RDONLY|O_BINARY, sharemode, S_STDRD);
     if (fh != -1)
     {
@@ -30,6 +30,9 @@ HashMgr::HashMgr(const char * tpath, const char * apath)
     aliasf = NULL;
     numaliasm = 0;
     aliasm = NULL;
+    pool = NULL;
+    poolptr = NULL;
+    poolleft = 0;
     load_config(apath);
     int ec = load_tables(tpath);
     if (ec)
@@ -40,6 +43,7 @@ HashMgr::HashMgr(const char * tpath, const char * apath)
         if (tableptr)
         {
             free(tableptr);
+            tableptr = NULL;
         }
         tablesize = 0;
     }
@@ -50,34 +54,27 @@ HashMgr::~HashMgr()
 {
     if (tableptr)
     {
-        // now pass through hash table freeing up everything
-        // go through column by column of the table
-        for (int i=0; i < tablesize; i++)
+        // words, descriptions and overflow entries live in the
+        // pool, only the flag vectors are owned per entry
+        if (!aliasf)
         {
-            struct hentry * pt = &tableptr[i];
-            struct hentry * nt = NULL;
-            if (pt)
+            for (int i=0; i < tablesize; i++)
             {
-                if (pt->astr && !aliasf) free(pt->astr);
-                if (pt->word) free(pt->word);
-                if (pt->description && !aliasm) free(pt->description);
-
-                pt = pt->next;
-            }
-            while(pt)
-            {
-                nt = pt->next;
-                if (pt->astr && !aliasf) free(pt->astr);
-                if (pt->word) free(pt->word);
-                if (pt->description && !aliasm) free(pt->description);
-                free(pt);
-                pt = nt;
+                for (struct hentry * pt = &tableptr[i]; pt; pt = pt->next)
+                    if (pt->astr) free(pt->astr);
             }
         }
         free(tableptr);
     }
     tablesize = 0;
 
+    while (pool)
+    {
+        char * prev = *(char **) pool;
+        free(pool);
+        pool = prev;
+    }
+
     if (aliasf)
     {
         for (int j = 0; j < (numaliasf); j++) free(aliasf[j]);
@@ -114,11 +111,49 @@ struct hentry * HashMgr::lookup(const char *word) const
     return NULL;
 }
 
+// allocate from the pool - a dictionary has tens of thousands of
+// short entries, carving them out of large chunks avoids a malloc
+// per word and lets the destructor drop them all at once
+
+#define POOLCHUNK 65536
+
+void * HashMgr::pool_alloc(size_t size)
+{
+    const size_t align = sizeof(void *);
+    size = (size + align - 1) & ~(align - 1);
+    if (size > poolleft)
+    {
+        size_t chunk = size + align > POOLCHUNK ? size + align : POOLCHUNK;
+        char * nc = (char *) malloc(chunk);
+        if (!nc) return NULL;
+        *(char **) nc = pool;
+        pool = nc;
+        poolptr = nc + align;
+        poolleft = chunk - align;
+    }
+    void * p = poolptr;
+    poolptr += size;
+    poolleft -= size;
+    return p;
+}
+
+char * HashMgr::pool_strdup(const char * s, size_t len)
+{
+    if (!s) return NULL;
+    char * d = (char *) pool_alloc(len + 1);
+    if (d)
+    {
+        memcpy(d, s, len);
+        d[len] = '\0';
+    }
+    return d;
+}
+
 // add a word to the hash table (private)
 
 int HashMgr::add_word(const char * word, int wl, unsigned short * aff, int al, const char * desc)
 {
-    char * st = mystrdup(word);
+    char * st = pool_strdup(word, word ? strlen(word) : 0);
     if (wl && !st) return 1;
     if (complexprefixes)
     {
@@ -137,11 +172,11 @@ int HashMgr::add_word(const char * word, int wl, unsigned short * aff, int al, c
         dp->next_homonym = NULL;
         if (aliasm)
         {
-            dp->description = (desc) ? get_aliasm(atoi(desc)) : mystrdup(desc);
+            dp->description = (desc) ? get_aliasm(atoi(desc)) : NULL;
         }
         else
         {
-            dp->description = mystrdup(desc);
+            dp->description = pool_strdup(desc, desc ? strlen(desc) : 0);
             if (desc && !dp->description) return 1;
             if (dp->description && complexprefixes)
             {
@@ -152,7 +187,7 @@ int HashMgr::add_word(const char * word, int wl, unsigned short * aff, int al, c
     }
     else
     {
-        struct hentry* hp = (struct hentry *) malloc (sizeof(struct hentry));
+        struct hentry* hp = (struct hentry *) pool_alloc(sizeof(struct hentry));
         if (!hp) return 1;
         hp->wlen = wl;
         hp->alen = al;
@@ -162,11 +197,11 @@ int HashMgr::add_word(const char * word, int wl, unsigned short * aff, int al, c
         hp->next_homonym = NULL;
         if (aliasm)
         {
-            hp->description = (desc) ? get_aliasm(atoi(desc)) : mystrdup(desc);
+            hp->description = (desc) ? get_aliasm(atoi(desc)) : NULL;
         }
         else
         {
-            hp->description = mystrdup(desc);
+            hp->description = pool_strdup(desc, desc ? strlen(desc) : 0);
             if (desc && !hp->description) return 1;
             if (dp->description && complexprefixes)
             {
@@ -246,6 +281,26 @@ struct hentry * HashMgr::walk_hashtable(int &col, struct hentry * hp) const
     return hp;
 }
 
+// cut the next line out of a buffer read by load_tables, the
+// line ending is replaced by a terminator - NULL at end of buffer
+static char * nextline(char *& next, char * end)
+{
+    if (next >= end) return NULL;
+    char * line = next;
+    char * nl = (char *) memchr(line, '\n', end - line);
+    if (nl)
+    {
+        *nl = '\0';
+        next = nl + 1;
+    }
+    else
+    {
+        next = end;
+    }
+    mychomp(line);
+    return line;
+}
+
 // load a munched word list and build a hash table on the fly
 int HashMgr::load_tables(const char * tpath)
 {
@@ -254,31 +309,63 @@ int HashMgr::load_tables(const char * tpath)
     char * dp;
     unsigned short * flags;
 
-    // raw dictionary - munched file
-    FILE * rawdict = fopen(tpath, "r");
+    // raw dictionary - munched file, read in one go and split in place
+    FILE * rawdict = fopen(tpath, "rb");
     if (rawdict == NULL) return 1;
+    long dictlen = -1;
+    if (fseek(rawdict, 0, SEEK_END) == 0)
+    {
+        dictlen = ftell(rawdict);
+        fseek(rawdict, 0, SEEK_SET);
+    }
+    if (dictlen <= 0)
+    {
+        fclose(rawdict);
+        return 2;
+    }
+    char * dict = (char *) malloc(dictlen + 1);
+    if (!dict)
+    {
+        fclose(rawdict);
+        return 3;
+    }
+    dictlen = (long) fread(dict, 1, dictlen, rawdict);
+    fclose(rawdict);
+    dict[dictlen] = '\0';
+    char * next = dict;
+    char * end = dict + dictlen;
 
     // first read the first line of file to get hash table size */
-    char ts[MAXDELEN];
-    if (! fgets(ts, MAXDELEN-1,rawdict)) return 2;
-    mychomp(ts);
+    char * ts = nextline(next, end);
+    if (!ts)
+    {
+        free(dict);
+        return 2;
+    }
     if ((*ts < '1') || (*ts > '9')) fprintf(stderr, "error - missing word count in dictionary file\n");
     tablesize = atoi(ts);
-    if (!tablesize) return 4;
+    if (!tablesize)
+    {
+        free(dict);
+        return 4;
+    }
     tablesize = tablesize + 5 + USERWORD;
     if ((tablesize %2) == 0) tablesize++;
 
     // allocate the hash table
     tableptr = (struct hentry *) calloc(tablesize, sizeof(struct hentry));
-    if (! tableptr) return 3;
+    if (! tableptr)
+    {
+        free(dict);
+        return 3;
+    }
     for (int i=0; i<tablesize; i++) tableptr[i].word = NULL;
 
     // loop through all words on much list and add to hash
     // table and create word and affix strings
 
-    while (fgets(ts,MAXDELEN-1,rawdict))
+    while ((ts = nextline(next, end)) != NULL)
     {
-        mychomp(ts);
         // split each line into word and morphological description
         dp = strchr(ts,'\t');
 
@@ -338,11 +425,15 @@ int HashMgr::load_tables(const char * tpath)
         wl = strlen(ts);
 
         // add the word and its index
-        if (add_word(ts,wl,flags,al,dp)) return 5;
+        if (add_word(ts,wl,flags,al,dp))
+        {
+            free(dict);
+            return 5;
+        }
 
     }
 
-    fclose(rawdict);
+    free(dict);
     return 0;
 }
 
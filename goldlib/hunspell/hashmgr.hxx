@@ -19,6 +19,9 @@ class HashMgr
     unsigned short *    aliasflen;
     int                 numaliasm; // morphological desciption `compression' with aliases
     char **             aliasm;
+    char *              pool;      // chunk arena for words, descriptions and overflow entries
+    char *              poolptr;
+    size_t              poolleft;
 
 
 public:
@@ -42,6 +45,8 @@ public:
 private:
     int load_tables(const char * tpath);
     int add_word(const char * word, int wl, unsigned short * ap, int al, const char * desc);
+    void * pool_alloc(size_t size);
+    char * pool_strdup(const char * s, size_t len);
     int load_config(const char * affpath);
     int parse_aliasf(char * line, FILE * af);
     int parse_aliasm(char * line, FILE * af);
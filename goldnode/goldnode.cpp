@@ -27,8 +27,8 @@
 // using namespace std;
 
 #include <gdbgerr.h>
-#include <list>
-#include <map>
+#include <algorithm>
+#include <vector>
 #include <clocale>
 #include <gdefs.h>
 #include <gcrcall.h>
@@ -65,64 +65,30 @@
 #define __gver_name__ __GVER_NAME__
 #define __gver_shortname__ __GVER_SHORTNAME__
 
-//  ------------------------------------------------------------------
-// 32-bit versions
-
-const size_t maxnodes = 262000;
-
-
 //  ------------------------------------------------------------------
 
 typedef std::vector<Addr>::iterator addr_iter;
 typedef std::vector<Stamp>::iterator stamp_iter;
 
-#if (_MSC_VER == 1200)
-class _geidxlist : public std::list<_GEIdx>
-{
-public:
-    void sort()
-    {
-        if (2 <= size())
-        {
-            const size_t _MAXN = 15;
-            _Myt _X(allocator), _A[_MAXN + 1];
-            size_t _N = 0;
+// Index records in the order they were read
+typedef std::vector<_GEIdx> geidxlist;
 
-            while (!empty())
-            {
-                _X.splice(_X.begin(), *this, begin());
-                size_t _I;
+// Record numbers in some sort order
+typedef std::vector<dword> geidxorder;
 
-                for (_I = 0; _I < _N && !_A[_I].empty(); ++_I)
-                {
-                    _A[_I].merge(_X);
-                    _A[_I].swap(_X);
-                }
+// Position in the .GXN of a record removed as a duplicate
+const dword gxn_dupe = 0xFFFFFFFFUL;
 
-                if (_I == _MAXN) _A[_I].merge(_X);
-                else
-                {
-                    _A[_I].swap(_X);
-                    if (_I == _N) ++_N;
-                }
-            }
-
-            for (int _NN = _N; _NN >= 0; _NN--)
-                merge(_A[_NN]);
-        }
-    }
-};
-
-typedef _geidxlist geidxlist;
-#else
-typedef std::list<_GEIdx> geidxlist;
-#endif
+// File number of a list that has none
+const uint gxl_none = 0xFF;
 
 // Nodelists
 std::vector<Stamp> nodelist; // nodelist files,stamps,update marker
 std::vector<Addr> nodezone;  // nodelist zones
 std::vector<Stamp> userlist; // Userlist files,stamps,update marker
 std::vector<Addr> userzone;  // Userlist zones
+std::vector<std::string> nodediff; // Nodediff masks, one per nodelist
+std::vector<uint> nodefileno;  // File number of each nodelist in the old .GXL
 std::vector< std::pair<std::string, std::string> > mappath;
 
 // Exclude/Include nodes
@@ -133,6 +99,7 @@ std::vector<Addr> includenode;
 std::string  addrindex;
 std::string  nodeindex;
 std::string  listindex;
+std::string  stampindex;
 
 //  ------------------------------------------------------------------
 
@@ -481,16 +448,31 @@ static bool cmp_anlsts(const _GEIdx &A, const _GEIdx &B)
 
 
 //  ------------------------------------------------------------------
-#if defined(_MSC_VER)
-enum { sort_by_address=0, sort_by_name } static sort_type;
-bool operator<(const _GEIdx &A, const _GEIdx &B)
+//  Sort record numbers by one of the compare functions above. The
+//  record number breaks ties, so the order is the same as with a
+//  stable sort of the records themselves.
+
+class GEIdxCmp
 {
-    if (sort_type==sort_by_address)
-        return cmp_anlsts(A, B);
-    else
-        return cmp_nnlsts(A, B);
-}
-#endif
+
+    const geidxlist* list;
+    bool (*cmp)(const _GEIdx&, const _GEIdx&);
+
+public:
+
+    GEIdxCmp(const geidxlist& l, bool (*c)(const _GEIdx&, const _GEIdx&)) : list(&l), cmp(c) {}
+
+    bool operator()(dword a, dword b) const
+    {
+        if(cmp((*list)[a], (*list)[b]))
+            return true;
+        if(cmp((*list)[b], (*list)[a]))
+            return false;
+        return a < b;
+    }
+};
+
+
 //  ------------------------------------------------------------------
 
 static char* CvtName(char* inp)
@@ -622,10 +604,172 @@ inline void index_line(char* p, char* ptrs[5])
 }
 
 
+//  ------------------------------------------------------------------
+//  Read a whole file into a NUL-terminated buffer
+
+static char* read_file(const char* file, long& len)
+{
+
+    gfile fp(file, "rb", sh_mod);
+    if(not fp.isopen())
+        return NULL;
+
+    len = fp.FileLength();
+    char* buf = (char*)throw_malloc(len+1);
+    if((len > 0) and (fp.Fread(buf, len) != 1))
+        len = 0;
+    buf[len] = NUL;
+    return buf;
+}
+
+
+//  ------------------------------------------------------------------
+//  Get the next line from a file buffer, the same way as fgets()
+
+static bool buf_gets(char* str, size_t size, const char*& ptr, const char* end)
+{
+
+    if((ptr >= end) or (size < 2))
+        return false;
+
+    const char* eol = (const char*)memchr(ptr, '\n', end - ptr);
+    size_t len = eol ? (eol - ptr + 1) : (end - ptr);
+    if(len > size - 1)
+        len = size - 1;
+
+    memcpy(str, ptr, len);
+    str[len] = NUL;
+    ptr += len;
+    return true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Checksum of the settings that decide which nodes are indexed
+
+static dword index_options()
+{
+
+    char buf[100];
+    dword crc = strCrc32(ignoredups ? "D" : "-", false, CRC32_MASK_CCITT);
+    addr_iter n;
+
+    for(n=excludenode.begin(); n != excludenode.end(); n++)
+        crc = strCrc32(make_addr_str(buf, &(*n), ""), false, crc);
+    crc = strCrc32("|", false, crc);
+    for(n=includenode.begin(); n != includenode.end(); n++)
+        crc = strCrc32(make_addr_str(buf, &(*n), ""), false, crc);
+    crc = strCrc32("|", false, crc);
+    for(n=nodezone.begin(); n != nodezone.end(); n++)
+        crc = strCrc32(make_addr_str(buf, &(*n), ""), false, crc);
+    crc = strCrc32("|", false, crc);
+    for(n=userzone.begin(); n != userzone.end(); n++)
+        crc = strCrc32(make_addr_str(buf, &(*n), ""), false, crc);
+
+    return crc;
+}
+
+
+//  ------------------------------------------------------------------
+//  Load the nodes of the unchanged lists from the old index, in name
+//  order, and their address order. Returns false if the index can't
+//  be updated and must be compiled from scratch.
+
+static bool load_index(geidxlist& nodeidx, geidxorder& addrorder, bool readusers, const std::vector<uint>& newfileno)
+{
+
+    char buf[256];
+    unsigned long options;
+    uint n;
+
+    // Nodes dropped as duplicates can't be brought back
+    if(ignoredups)
+        return false;
+#ifdef GOLDNODE_STATS
+    if(make_stats)
+        return false;
+#endif
+
+    // The index must be made with the same settings
+    gfile fp(stampindex.c_str(), "rt", sh_mod);
+    if(not fp.isopen() or not fp.Fgets(buf, sizeof(buf)))
+        return false;
+    fp.Fclose();
+    if((sscanf(buf, "; options %lx", &options) != 1) or (options != index_options()))
+        return false;
+
+    // Nodelists by their file number in the old index
+    std::vector<uint> oldlist(256, gxl_none);
+    for(n=0; n<nodelist.size(); n++)
+    {
+        if(nodefileno[n] != gxl_none)
+            oldlist[nodefileno[n]] = n;
+    }
+
+    long nlen = 0, alen = 0;
+    char* nbuf = read_file(nodeindex.c_str(), nlen);
+    char* abuf = read_file(addrindex.c_str(), alen);
+    dword count = nlen / sizeof(_GEIdx);
+    bool ok = nbuf and abuf and ((nlen % sizeof(_GEIdx)) == 0) and (alen == (long)(count*sizeof(dword)));
+
+    if(ok)
+    {
+        // Keep the nodes of unchanged lists, noting their new numbers
+        geidxorder remap(count, gxn_dupe);
+        dword i;
+        for(i = 0; i < count; i++)
+        {
+            _GEIdx node;
+            memcpy(&node, nbuf + i*sizeof(_GEIdx), sizeof(_GEIdx));
+            uint fileno = node.pos >> 24;
+            bool keep;
+            if(fileno == gxl_none)
+                keep = not readusers;
+            else
+            {
+                // Kept nodes get the number of their list in the new index
+                uint list = oldlist[fileno];
+                keep = (list != gxl_none) and not nodelist[list].fc and (newfileno[list] != gxl_none);
+                if(keep)
+                    node.pos = (node.pos & 0x00FFFFFFL) | (((dword)newfileno[list]) << 24);
+            }
+            if(keep)
+            {
+                remap[i] = nodeidx.size();
+                nodeidx.push_back(node);
+            }
+        }
+
+        for(i = 0; i < count; i++)
+        {
+            dword namepos;
+            memcpy(&namepos, abuf + i*sizeof(dword), sizeof(dword));
+            if(namepos >= count)
+            {
+                ok = false;
+                break;
+            }
+            if(remap[namepos] != gxn_dupe)
+                addrorder.push_back(remap[namepos]);
+        }
+    }
+
+    throw_xfree(nbuf);
+    throw_xfree(abuf);
+
+    if(not ok)
+    {
+        nodeidx.clear();
+        addrorder.clear();
+    }
+    return ok;
+}
+
+
 //  ------------------------------------------------------------------
 //  Read the nodelists and userlists
 
-static void read_nodelists()
+static void read_nodelists(bool update)
 {
     gfile lfp;
     long pos;
@@ -639,12 +783,37 @@ static void read_nodelists()
     const char* name;
     char* lp[5];
     geidxlist nodeidx;
+    geidxorder oldaddr;
     stamp_iter fno;
     addr_iter zno;
 
-    nodes = 0;
+    // Userlists share one file number, so they are read all or none
+    bool readusers = not update;
+    for(fno=userlist.begin(); fno != userlist.end(); fno++)
+    {
+        if(fno->fc)
+            readusers = true;
+    }
 
-    if(not quiet) std::cout << std::endl << "* Compiling nodelists:" << std::endl;
+    // The lists that can be read are numbered in order
+    std::vector<uint> newfileno(nodelist.size(), gxl_none);
+    for(no=0, realfno=0; no<nodelist.size(); no++)
+    {
+        if(fexist(nodelist[no].fn))
+            newfileno[no] = realfno++;
+    }
+
+    // Start from the old index when only some lists have changed
+    if(update and not load_index(nodeidx, oldaddr, readusers, newfileno))
+    {
+        update = false;
+        readusers = true;
+    }
+    size_t kept = nodeidx.size();
+
+    nodes = kept;
+
+    if(not quiet) std::cout << std::endl << (update ? "* Updating nodelist index:" : "* Compiling nodelists:") << std::endl;
 
     // Delete the current indexfiles so they don't take up space
     remove(addrindex.c_str());
@@ -654,221 +823,237 @@ static void read_nodelists()
     for(realfno=0, fno=nodelist.begin(), zno=nodezone.begin(); fno != nodelist.end(); fno++, zno++)
     {
 
-        if (nodes < maxnodes)
+        name = CleanFilename(fno->fn);
+
+        // Keep the nodes of an unchanged nodelist from the old index
+        if(update and not fno->fc and (newfileno[fno-nodelist.begin()] != gxl_none))
         {
-            lfp.Fopen(fno->fn, "rb", sh_mod);
-            if (lfp.isopen())
+            if(not quiet)
             {
-                lfp.SetvBuf(NULL, _IOFBF, 32000);
-                fno->ft = GetFiletime(fno->fn);
-
-                // Initialize for each nodelist file
-                no = 0;
-                pos = 0;
-                line = 0;
-                point = YES;
-                nlst.reset();
-                nlstz = nlst.addr = *zno;
-                name = CleanFilename(fno->fn);
+                int len = 16-strlen(name);
+                std::cout << "\r* " << ((fno == nodelist.end()-1) ? '\\' : '|') << "--" << name << std::setw((len > 0) ? len : 1) << " " << "Unchanged" << std::endl;
+            }
+            ++realfno;
+            continue;
+        }
 
-                // Read all nodes
-                while (lfp.Fgets(buf, sizeof(buf)))
-                {
-                    line++;
+        // Read the whole nodelist at once
+        long flen;
+        char* fbuf = read_file(fno->fn, flen);
+        if (fbuf)
+        {
+            fno->ft = GetFiletime(fno->fn);
+            const char* fptr = fbuf;
+            const char* fend = fbuf + flen;
+
+            // Initialize for each nodelist file
+            no = 0;
+            pos = 0;
+            line = 0;
+            point = YES;
+            nlst.reset();
+            nlstz = nlst.addr = *zno;
+
+            // Read all nodes
+            while (buf_gets(buf, sizeof(buf), fptr, fend))
+            {
+                line++;
 
-                    // Break out if eof-marker is found
-                    if(*buf == '\x1A')
-                        break;
+                // Break out if eof-marker is found
+                if(*buf == '\x1A')
+                    break;
 
-                    // Note file position
-                    nlst.pos = pos;
+                // Note file position
+                nlst.pos = pos;
 
-                    // Get line length and fix possible errors
-                    uint llen = strlen(buf);
-                    ptr = buf+llen-1;
-                    while(llen and not (*ptr == '\r' or *ptr == '\n' or *ptr == '\x1A'))
+                // Get line length and fix possible errors
+                uint llen = strlen(buf);
+                ptr = buf+llen-1;
+                while(llen and not (*ptr == '\r' or *ptr == '\n' or *ptr == '\x1A'))
+                {
+                    buf[llen] = ' ';
+                    if(not quiet)
                     {
-                        buf[llen] = ' ';
-                        if(not quiet)
-                        {
-                            int len = 16-strlen(name);
-                            std::cout << "\r* |--" << name << std::setw((len > 0) ? len : 1) << " " << "Warning line " << line << " - Invalid NUL char encountered." << std::endl;
-                        }
-                        llen = strlen(buf);
-                        ptr = buf+llen-1;
+                        int len = 16-strlen(name);
+                        std::cout << "\r* |--" << name << std::setw((len > 0) ? len : 1) << " " << "Warning line " << line << " - Invalid NUL char encountered." << std::endl;
                     }
-                    pos += llen;
+                    llen = strlen(buf);
+                    ptr = buf+llen-1;
+                }
+                pos += llen;
 
-                    // Skip whitespace
-                    ptr = buf;
-                    while(isspace(*ptr))
-                        ptr++;
+                // Skip whitespace
+                ptr = buf;
+                while(isspace(*ptr))
+                    ptr++;
 
-                    if(*ptr != ';' and *ptr)
-                    {
+                if(*ptr != ';' and *ptr)
+                {
 
-                        // First test for FD pvt extension
-                        if(toupper(*ptr) == 'B')     // Boss
-                        {
-                            nlst.addr.reset();
-                            parse_address(ptr+5, &nlst.addr, &nlstz);
-                            point = YES;
-                            continue;
-                        }
+                    // First test for FD pvt extension
+                    if(toupper(*ptr) == 'B')     // Boss
+                    {
+                        nlst.addr.reset();
+                        parse_address(ptr+5, &nlst.addr, &nlstz);
+                        point = YES;
+                        continue;
+                    }
 
-                        // Test for Goldware extension
-                        if(isdigit(*ptr))
-                        {
-                            nlst.addr.reset();
-                            parse_address(ptr+5, &nlst.addr, &nlstz);
-                            point = YES;
-                        }
+                    // Test for Goldware extension
+                    if(isdigit(*ptr))
+                    {
+                        nlst.addr.reset();
+                        parse_address(ptr+5, &nlst.addr, &nlstz);
+                        point = YES;
+                    }
 
-                        // Hold,32,TriCom,Hornbaek,Lars_Joergensen,45-12345678,2400,XX
+                    // Hold,32,TriCom,Hornbaek,Lars_Joergensen,45-12345678,2400,XX
 
-                        // Form the full node address
-                        index_line(ptr, lp);
+                    // Form the full node address
+                    index_line(ptr, lp);
 
-                        // NOTE: I use the fact that the third letter in lp[0] is unique
-                        //       for all valid attrs to speed up processing
+                    // NOTE: I use the fact that the third letter in lp[0] is unique
+                    //       for all valid attrs to speed up processing
 
-                        switch(*lp[0] ? toupper(lp[0][2]) : 0)
-                        {
-                        case 'N':   // zone
-                            nlst.addr.zone = nlst.addr.net = atow(lp[1]);
-                            nlst.addr.node = nlst.addr.point = 0;
-                            point = NO;
-                            break;
+                    switch(*lp[0] ? toupper(lp[0][2]) : 0)
+                    {
+                    case 'N':   // zone
+                        nlst.addr.zone = nlst.addr.net = atow(lp[1]);
+                        nlst.addr.node = nlst.addr.point = 0;
+                        point = NO;
+                        break;
 
-                        case 'G':   // Region
-                            nlst.addr.net = atow(lp[1]);
-                            nlst.addr.node = nlst.addr.point = 0;
-                            point = NO;
-                            if(nlst.addr.net >= 10000)
-                                continue;
-                            break;
+                    case 'G':   // Region
+                        nlst.addr.net = atow(lp[1]);
+                        nlst.addr.node = nlst.addr.point = 0;
+                        point = NO;
+                        if(nlst.addr.net >= 10000)
+                            continue;
+                        break;
 
-                        case 'S':   // Host
+                    case 'S':   // Host
+                    {
+                        nlst.addr.net = atow(lp[1]);
+                        nlst.addr.node = nlst.addr.point = 0;
+                        point = NO;
+                        Addr a;
+                        fast_parse_addr(lp[2],&a);
+                        if(a.net)                     // Is POINTS24 format ?
                         {
-                            nlst.addr.net = atow(lp[1]);
-                            nlst.addr.node = nlst.addr.point = 0;
-                            point = NO;
-                            Addr a;
-                            fast_parse_addr(lp[2],&a);
-                            if(a.net)                     // Is POINTS24 format ?
-                            {
-                                nlst.addr.net = a.net;
-                                nlst.addr.node = a.node;
-                                nlst.addr.point = 0;
-                                point = YES;
-                            }
+                            nlst.addr.net = a.net;
+                            nlst.addr.node = a.node;
+                            nlst.addr.point = 0;
+                            point = YES;
                         }
+                    }
+                    break;
+
+                    case 'B':   // Hub
+                        nlst.addr.node = atow(lp[1]);
+                        nlst.addr.point = 0;
+                        point = NO;
                         break;
 
-                        case 'B':   // Hub
+                    case 'I':   // point
+                        nlst.addr.point = atow(lp[1]);
+                        break;
+
+                    case 'T':   // Pvt
+                    case 'W':   // Down
+                    case 'L':   // Hold
+                    default:
+                        if(point)
+                            nlst.addr.point = atow(lp[1]);
+                        else
+                        {
                             nlst.addr.node = atow(lp[1]);
                             nlst.addr.point = 0;
-                            point = NO;
-                            break;
+                        }
+                        break;
+                    }
 
-                        case 'I':   // point
-                            nlst.addr.point = atow(lp[1]);
-                            break;
+                    if(ISTWIRLY(no))
+                    {
+                        int len = 16-strlen(name);
+                        std::cout << "\r* \\--" << name << std::setw((len > 0) ? len : 1) << " " << "Zone " << nlst.addr.zone << "   \tNet " << nlst.addr.net << "   \tNodes " << (uint32_t)no << "        " << std::flush;
+                    }
 
-                        case 'T':   // Pvt
-                        case 'W':   // Down
-                        case 'L':   // Hold
-                        default:
-                            if(point)
-                                nlst.addr.point = atow(lp[1]);
-                            else
-                            {
-                                nlst.addr.node = atow(lp[1]);
-                                nlst.addr.point = 0;
-                            }
-                            break;
-                        }
+                    bool include = true;
 
-                        if(ISTWIRLY(no))
+                    // Check address against the exclude masks
+                    for(addr_iter n=excludenode.begin(); n != excludenode.end(); n++)
+                    {
+                        if(match_addr_mask(&(*n), &nlst.addr))
                         {
-                            int len = 16-strlen(name);
-                            std::cout << "\r* \\--" << name << std::setw((len > 0) ? len : 1) << " " << "Zone " << nlst.addr.zone << "   \tNet " << nlst.addr.net << "   \tNodes " << (uint32_t)no << "        " << std::flush;
+                            include = false;
+                            break;
                         }
+                    }
 
-                        bool include = true;
-
-                        // Check address against the exclude masks
-                        for(addr_iter n=excludenode.begin(); n != excludenode.end(); n++)
+                    // Check address against the include masks
+                    if(not include)
+                    {
+                        for(addr_iter n=includenode.begin(); n != includenode.end(); n++)
                         {
                             if(match_addr_mask(&(*n), &nlst.addr))
                             {
-                                include = false;
+                                include = true;
                                 break;
                             }
                         }
+                    }
 
-                        // Check address against the include masks
-                        if(not include)
-                        {
-                            for(addr_iter n=includenode.begin(); n != includenode.end(); n++)
-                            {
-                                if(match_addr_mask(&(*n), &nlst.addr))
-                                {
-                                    include = true;
-                                    break;
-                                }
-                            }
-                        }
-
-                        if(include)     // Address was okay
-                        {
-
-                            // Convert name to Goldware standard
-                            strxcpy(nlst.name, CvtName(lp[4]), sizeof(nlst.name));
+                    if(include)     // Address was okay
+                    {
 
-                            // Prepare the rest
-                            nlst.pos |= ((((dword)realfno) << 24) & 0xFF000000L);
+                        // Convert name to Goldware standard
+                        strxcpy(nlst.name, CvtName(lp[4]), sizeof(nlst.name));
 
-                            // Append to end of list
-                            nodeidx.push_back(nlst);
-                            ++nodes;
+                        // Prepare the rest
+                        nlst.pos |= ((((dword)realfno) << 24) & 0xFF000000L);
 
-                            // Count the node
-                            no++;
+                        // Append to end of list
+                        nodeidx.push_back(nlst);
+                        ++nodes;
 
-                            // Stop if limit is reached
-                            if(nodes >= maxnodes)
-                                break;
-                        }
+                        // Count the node
+                        no++;
                     }
                 }
+            }
 
-                if(not quiet)
-                {
-                    int len = 16-strlen(name);
-                    std::cout << "\r* " << ((fno == nodelist.end()-1) ? '\\' : '|') << "--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes read: " << (uint32_t)no << "\tTotal read: " << (uint32_t)nodes << ((nodes >= maxnodes) ? " (Limit reached)" : "                ") << std::endl;
-                }
-
-                lfp.Fclose();
-                ++realfno;
+            if(not quiet)
+            {
+                int len = 16-strlen(name);
+                std::cout << "\r* " << ((fno == nodelist.end()-1) ? '\\' : '|') << "--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes read: " << (uint32_t)no << "\tTotal read: " << (uint32_t)nodes << "                " << std::endl;
             }
-            else
+
+            throw_free(fbuf);
+            ++realfno;
+        }
+        else
+        {
+            if(not quiet) std::cout << "Error opening nodelist " << fno->fn << '!' << std::endl;
+
+            // The file numbers of the following lists would be wrong
+            if(update and (newfileno[fno-nodelist.begin()] != gxl_none))
             {
-                if(not quiet) std::cout << "Error opening nodelist " << fno->fn << '!' << std::endl;
-                *(fno->fn) = NUL;
+                read_nodelists(false);
+                return;
             }
+            *(fno->fn) = NUL;
         }
     }
 
     // Compile userlists
-    if(userlist.size())
+    if(userlist.size() and readusers)
     {
         if(not quiet) std::cout << std::endl << "* Compiling userlists:" << std::endl;
     }
 
     pos = 0;
 
-    for(fno=userlist.begin(), zno=userzone.begin(); fno != userlist.end() and nodes < maxnodes; fno++, zno++)
+    for(fno=userlist.begin(), zno=userzone.begin(); readusers and (fno != userlist.end()); fno++, zno++)
     {
 
         no = 0;
@@ -877,95 +1062,89 @@ static void read_nodelists()
         if (lfp.isopen())
         {
             lfp.SetvBuf(NULL, _IOFBF, 32000);
+            fno->ft = GetFiletime(fno->fn);
 
             name = CleanFilename(fno->fn);
 
-            if (nodes < maxnodes)
+            while (lfp.Fgets(buf, sizeof(buf)))
             {
-                while (lfp.Fgets(buf, sizeof(buf)))
+                // Get node data
+                strbtrim(buf);
+                ptr = buf + strlen(buf) - 1;
+                while(*ptr != ' ')
+                    ptr--;
+                nlst.reset();
+                nlst.addr = *zno;
+                fast_parse_addr(ptr+1, &nlst.addr);
+                *ptr = NUL;
+                strbtrim(buf);
+
+                // Convert "lastname, firstname" to "firstname lastname"
+                ptr = strchr(buf, ',');
+                if(ptr)
                 {
-                    // Get node data
-                    strbtrim(buf);
-                    ptr = buf + strlen(buf) - 1;
-                    while(*ptr != ' ')
-                        ptr--;
-                    nlst.reset();
-                    nlst.addr = *zno;
-                    fast_parse_addr(ptr+1, &nlst.addr);
-                    *ptr = NUL;
-                    strbtrim(buf);
-
-                    // Convert "lastname, firstname" to "firstname lastname"
-                    ptr = strchr(buf, ',');
-                    if(ptr)
-                    {
-                        *ptr++ = NUL;
-                        strxmerge(buf2, 100, strskip_wht(ptr), " ", buf, NULL);
-                        ptr = buf2;
-                    }
-                    else
-                    {
-                        ptr = buf;
-                    }
+                    *ptr++ = NUL;
+                    strxmerge(buf2, 100, strskip_wht(ptr), " ", buf, NULL);
+                    ptr = buf2;
+                }
+                else
+                {
+                    ptr = buf;
+                }
 
-                    // Convert name to Goldware standard
-                    strxcpy(nlst.name, CvtName(ptr), sizeof(nlst.name));
+                // Convert name to Goldware standard
+                strxcpy(nlst.name, CvtName(ptr), sizeof(nlst.name));
 
-                    bool include = true;
+                bool include = true;
 
-                    // Check address against the exclude masks
-                    for(addr_iter n=excludenode.begin(); n != excludenode.end(); n++)
+                // Check address against the exclude masks
+                for(addr_iter n=excludenode.begin(); n != excludenode.end(); n++)
+                {
+                    if(match_addr_mask(&(*n), &nlst.addr))
                     {
-                        if(match_addr_mask(&(*n), &nlst.addr))
-                        {
-                            include = false;
-                            break;
-                        }
+                        include = false;
+                        break;
                     }
+                }
 
-                    // Check address against the include masks
-                    if(not include)
+                // Check address against the include masks
+                if(not include)
+                {
+                    for(addr_iter n=includenode.begin(); n != includenode.end(); n++)
                     {
-                        for(addr_iter n=includenode.begin(); n != includenode.end(); n++)
+                        if(match_addr_mask(&(*n), &nlst.addr))
                         {
-                            if(match_addr_mask(&(*n), &nlst.addr))
-                            {
-                                include = true;
-                                break;
-                            }
+                            include = true;
+                            break;
                         }
                     }
+                }
 
-                    if(include)     // Address was okay
-                    {
-
-                        if(ISTWIRLY(nodes))
-                        {
-                            int len = 16-strlen(name);
-                            std::cout << "\r* \\--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes: " << (uint32_t)nodes << "        " << std::flush;
-                        }
+                if(include)     // Address was okay
+                {
 
-                        // Indicate userlist
-                        nlst.pos = (long)0xFF000000L | (pos++);
+                    if(ISTWIRLY(nodes))
+                    {
+                        int len = 16-strlen(name);
+                        std::cout << "\r* \\--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes: " << (uint32_t)nodes << "        " << std::flush;
+                    }
 
-                        // Append to end of list
-                        nodeidx.push_back(nlst);
-                        ++nodes;
+                    // Indicate userlist
+                    nlst.pos = (long)0xFF000000L | (pos++);
 
-                        // Count the node
-                        no++;
+                    // Append to end of list
+                    nodeidx.push_back(nlst);
+                    ++nodes;
 
-                        // Stop if limit is reached
-                        if(nodes >= maxnodes)
-                            break;
-                    }
+                    // Count the node
+                    no++;
                 }
             }
 
             if(not quiet)
             {
                 int len = 16-strlen(name);
-                std::cout << "\r* " << ((fno == userlist.end()-1) ? '\\' : '|') << "--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes read: " << (uint32_t)no << "\tTotal read: " << (uint32_t)nodes << ((nodes >= maxnodes) ? " (Limit reached)" : "                ") << std::endl;
+                std::cout << "\r* " << ((fno == userlist.end()-1) ? '\\' : '|') << "--" << name << std::setw((len > 0) ? len : 1) << " " << "Nodes read: " << (uint32_t)no << "\tTotal read: " << (uint32_t)nodes << "                " << std::endl;
             }
 
             lfp.Fclose();
@@ -1003,17 +1182,18 @@ static void read_nodelists()
     {
 #endif
         // At last, sort the nodes
-        geidxlist::iterator curr, prev;
-        std::map<long, dword> namepos;
+        geidxorder order(nodeidx.size());
+        geidxorder namepos(nodeidx.size(), gxn_dupe);
+        geidxorder::iterator curr;
+        dword n, prev;
 
         // Sort by name
         if(not quiet) std::cout << NL << "* Sorting by name " << std::flush;
-#if defined(_MSC_VER)
-        sort_type = sort_by_name;
-        nodeidx.sort();
-#else
-        nodeidx.sort(cmp_nnlsts);
-#endif
+        for(n = 0; n < order.size(); n++)
+            order[n] = n;
+        std::sort(order.begin()+kept, order.end(), GEIdxCmp(nodeidx, cmp_nnlsts));
+        std::inplace_merge(order.begin(), order.begin()+kept, order.end(), GEIdxCmp(nodeidx, cmp_nnlsts));
+
         // Write the name-sorted .GXN
         gfile fp(nodeindex.c_str(), "wb", sh_mod);
         if (fp.isopen())
@@ -1035,51 +1215,59 @@ static void read_nodelists()
 
             int nn = 0;
             dword nodenum = 0;
-            for(prev = nodeidx.end(), curr = nodeidx.begin(); curr != nodeidx.end(); prev = curr++)
+            for(prev = gxn_dupe, curr = order.begin(); curr != order.end(); curr++)
             {
 
                 if(ISTWIRLY(nn++))
                     twirly();
 
+                _GEIdx& node = nodeidx[*curr];
+
                 if(ignoredups)
                 {
-                    if(prev != nodeidx.end() && match_addr_mask(&curr->addr, &prev->addr))
+                    if(prev != gxn_dupe && match_addr_mask(&node.addr, &nodeidx[prev].addr))
                     {
-                        if(strieql(curr->name, prev->name))
+                        if(strieql(node.name, nodeidx[prev].name))
                         {
 #ifdef DEBUG
-                            if(not quiet) std::cout << "* Dupe: " << curr->addr.zone << ':' << curr->addr.net << '/' << curr->addr.node << '.' << curr->addr.point << ' ' << curr->name << NL;
+                            if(not quiet) std::cout << "* Dupe: " << node.addr.zone << ':' << node.addr.net << '/' << node.addr.node << '.' << node.addr.point << ' ' << node.name << NL;
 #endif
-                            nodeidx.erase(curr);
-                            curr = prev;
                             ++dups;
                             continue;
                         }
                     }
-                    fp.Fwrite(&(*curr), sizeof(_GEIdx));
+                    prev = *curr;
                 }
-                else
-                    fp.Fwrite(&(*curr), sizeof(_GEIdx));
 
-                namepos[curr->pos] = nodenum++;
+                fp.Fwrite(&node, sizeof(_GEIdx));
+
+                namepos[*curr] = nodenum++;
                 if (fidouser)
                 {
                     char buf[256];
-                    fido.Printf("%-36.36s%24.24s\n", curr->name, make_addr_str(buf, &curr->addr, ""));
+                    fido.Printf("%-36.36s%24.24s\n", node.name, make_addr_str(buf, &node.addr, ""));
                 }
             }
 
             fp.Fclose();
         }
 
-        // Sort by address
+        // Sort by address, leaving out the duplicates
         if(not quiet) std::cout << ' ' << NL "* Sorting by node " << std::flush;
-#if defined(_MSC_VER)
-        sort_type = sort_by_address;
-        nodeidx.sort();
-#else
-        nodeidx.sort(cmp_anlsts);
-#endif
+        order.clear();
+        for(curr = oldaddr.begin(); curr != oldaddr.end(); curr++)
+        {
+            if(namepos[*curr] != gxn_dupe)
+                order.push_back(*curr);
+        }
+        size_t merged = order.size();
+        for(n = kept; n < namepos.size(); n++)
+        {
+            if(namepos[n] != gxn_dupe)
+                order.push_back(n);
+        }
+        std::sort(order.begin()+merged, order.end(), GEIdxCmp(nodeidx, cmp_anlsts));
+        std::inplace_merge(order.begin(), order.begin()+merged, order.end(), GEIdxCmp(nodeidx, cmp_anlsts));
 
         // Write the address-sorted .GXA
         fp.Fopen(addrindex.c_str(), "wb", sh_mod);
@@ -1088,11 +1276,11 @@ static void read_nodelists()
             name = CleanFilename(addrindex.c_str());
             if(not quiet) std::cout << "\b, writing " << name << ' ' << std::flush;
             int nn = 0;
-            for(curr = nodeidx.begin(); curr != nodeidx.end(); curr++)
+            for(curr = order.begin(); curr != order.end(); curr++)
             {
                 if(ISTWIRLY(nn++))
                     twirly();
-                fp.Fwrite(&namepos[curr->pos], sizeof(dword));
+                fp.Fwrite(&namepos[*curr], sizeof(dword));
             }
             fp.Fclose();
         }
@@ -1112,6 +1300,17 @@ static void read_nodelists()
             fp.Fclose();
         }
 
+        // Write the index settings and userlist stamps in .GXS
+        fp.Fopen(stampindex.c_str(), "wt", sh_mod);
+        if (fp.isopen())
+        {
+            fp.Printf("; options %08lx\n", (unsigned long)index_options());
+            for (fno=userlist.begin(); fno != userlist.end(); fno++)
+                fp.Printf("%s %u\n", fno->fn, fno->ft);
+
+            fp.Fclose();
+        }
+
         // Note compile time
         runtime = gtime(NULL) - runtime;
 
@@ -1129,6 +1328,270 @@ static void read_nodelists()
 }
 
 
+//  ------------------------------------------------------------------
+//  Length of the line at ptr, including the line end
+
+static size_t line_len(const char* ptr, const char* end)
+{
+
+    const char* eol = (const char*)memchr(ptr, '\n', end - ptr);
+    return eol ? (eol - ptr + 1) : (end - ptr);
+}
+
+
+//  ------------------------------------------------------------------
+//  Read the first line of a file, without the line end
+
+static bool first_line(const char* file, char* buf, size_t size)
+{
+
+    gfile fp(file, "rb", sh_mod);
+    if(not fp.isopen() or not fp.Fgets(buf, size))
+        return false;
+    strtrim(buf);
+    return true;
+}
+
+
+//  ------------------------------------------------------------------
+//  Check the CRC-16 given at the end of the first line of a nodelist.
+//  It covers everything after the first line, up to the EOF marker.
+
+static bool nodelist_crc_ok(const std::string& list)
+{
+
+    const char* ptr = list.data();
+    const char* end = ptr + list.length();
+    size_t len = line_len(ptr, end);
+
+    std::string head(ptr, len);
+    strtrim(head);
+    std::string::size_type colon = head.rfind(':');
+    if(colon == head.npos)
+        return true;    // No CRC to check
+    const char* crcptr = strskip_wht(head.c_str()+colon+1);
+    if(not isdigit(*crcptr))
+        return true;
+    long wanted = atol(crcptr);
+
+    word crc = 0;
+    for(ptr += len; (ptr < end) and (*ptr != '\x1A'); ptr++)
+        crc = updCrc16c(*ptr, crc);
+
+    return crc == wanted;
+}
+
+
+//  ------------------------------------------------------------------
+//  Apply a nodediff to a nodelist and write the result to target.
+//  Returns false if the diff is not for this nodelist or is damaged.
+
+static bool apply_nodediff(const char* list, const char* diff, const char* target)
+{
+
+    char lhead[512], dhead[512];
+
+    // The first line of the diff is the first line of the old list
+    if(not first_line(list, lhead, sizeof(lhead)) or not first_line(diff, dhead, sizeof(dhead)))
+        return false;
+    if(not *lhead or not streql(lhead, dhead))
+        return false;
+
+    long llen = 0, dlen = 0;
+    char* lbuf = read_file(list, llen);
+    char* dbuf = read_file(diff, dlen);
+    bool ok = lbuf and dbuf;
+
+    if(ok)
+    {
+        const char* lptr = lbuf;
+        const char* lend = lbuf + llen;
+        const char* dptr = dbuf;
+        const char* dend = dbuf + dlen;
+        std::string result;
+
+        result.reserve(llen + dlen);
+        dptr += line_len(dptr, dend);
+
+        while(ok and (dptr < dend) and (*dptr != '\x1A'))
+        {
+            size_t len = line_len(dptr, dend);
+            char cmd = toupper(*dptr);
+            long count = atol(dptr+1);
+            dptr += len;
+
+            switch(cmd)
+            {
+            case 'A':   // Add lines from the diff
+                for(; (count > 0) and (dptr < dend); count--)
+                {
+                    len = line_len(dptr, dend);
+                    result.append(dptr, len);
+                    dptr += len;
+                }
+                break;
+
+            case 'C':   // Copy lines from the old list
+            case 'D':   // Delete lines from the old list
+                for(; (count > 0) and (lptr < lend) and (*lptr != '\x1A'); count--)
+                {
+                    len = line_len(lptr, lend);
+                    if(cmd == 'C')
+                        result.append(lptr, len);
+                    lptr += len;
+                }
+                break;
+
+            case '\r':
+            case '\n':
+                count = 0;
+                break;
+
+            default:
+                ok = false;
+            }
+
+            if(count > 0)
+                ok = false;
+        }
+
+        if(ok)
+        {
+            if((llen > 0) and (lbuf[llen-1] == '\x1A'))
+                result += '\x1A';
+
+            ok = nodelist_crc_ok(result);
+        }
+
+        if(ok)
+        {
+            gfile fp(target, "wb", sh_mod);
+            ok = fp.isopen();
+            if(ok)
+            {
+                fp.Fwrite(result.data(), result.length());
+                ok = fp.okay();
+                fp.Fclose();
+                if(not ok)
+                    remove(target);
+            }
+        }
+
+        if(not quiet)
+        {
+            if(ok)
+                std::cout << "* Applied " << CleanFilename(diff) << " to " << CleanFilename(list) << ", created " << CleanFilename(target) << NL;
+            else
+                std::cout << "* Error applying " << CleanFilename(diff) << " to " << CleanFilename(list) << '!' << NL;
+        }
+    }
+
+    throw_xfree(lbuf);
+    throw_xfree(dbuf);
+    return ok;
+}
+
+
+//  ------------------------------------------------------------------
+//  Bring a nodelist up to date with the nodediffs matching mask
+
+static void apply_nodediffs(Stamp& list, const char* mask)
+{
+
+    Path dir, name, base, diff, target;
+
+    extractdirname(dir, mask);
+    strxcpy(name, CleanFilename(mask), sizeof(Path));
+    char* ext = strchr(name, '.');
+    if(ext == NULL)
+        return;
+    int extpos = ext-name+1;
+    strcpy(ext, ".*");
+
+    // Each new nodelist may be followed by the next diff
+    bool applied = true;
+    while(applied)
+    {
+        applied = false;
+
+        strxcpy(base, list.fn, sizeof(Path));
+        ext = strchr(base + (CleanFilename(base) - base), '.');
+        if(ext)
+            *ext = NUL;
+
+        gposixdir f(dir);
+        const gdirentry *de;
+        while((de = f.nextentry(name)) != NULL)
+        {
+            const char* diffext = de->name.c_str()+extpos;
+            if(not atoi(diffext))
+                continue;
+
+            // The new nodelist gets the extension of the diff
+            strxmerge(target, sizeof(Path), base, ".", diffext, NULL);
+            if(fexist(target))
+                continue;
+
+            strxmerge(diff, sizeof(Path), dir, de->name.c_str(), NULL);
+            if(apply_nodediff(list.fn, diff, target))
+            {
+                strxcpy(list.fn, target, sizeof(Path));
+                applied = true;
+                break;
+            }
+        }
+    }
+}
+
+
+//  ------------------------------------------------------------------
+//  Get the timestamps noted in a .GXL or .GXS file. Lists are matched
+//  by name; with fileno, the line number of each list is noted too.
+
+static bool read_stamps(const char* file, std::vector<Stamp>& list, std::vector<uint>* fileno)
+{
+
+    Path buf, name;
+    uint n, line = 0;
+
+    if(fileno)
+        fileno->assign(list.size(), gxl_none);
+
+    gfile fp(file, "rt", sh_mod);
+    if (not fp.isopen())
+        return false;
+
+    while (fp.Fgets(buf, sizeof(buf)))
+    {
+        if(*buf == ';')
+            continue;
+
+        char* key;
+        char* val=buf;
+        getkeyval(&key, &val);
+        key = strxcpy(name, strbtrim(key), sizeof(Path));
+        _MapPath(key);
+        strchg(key, GOLD_WRONG_SLASH_CHR, GOLD_SLASH_CHR);
+        for(n = 0; n < list.size(); n++)
+        {
+            if(fileno and ((*fileno)[n] != gxl_none))
+                continue;
+            if(strieql(list[n].fn, key))
+            {
+                list[n].ft = atol(val);
+                if(fileno)
+                    (*fileno)[n] = line;
+                break;
+            }
+        }
+        line++;
+    }
+    fp.Fclose();
+
+    return true;
+}
+
+
 //  ------------------------------------------------------------------
 
 static void check_nodelists(bool force)
@@ -1166,44 +1629,31 @@ static void check_nodelists(bool force)
         }
     }
 
-    // Get timestamps from .GXL file
-    gfile fp(listindex.c_str(), "rt", sh_mod);
-    if (fp.isopen())
+    // Apply new nodediffs
+    for(n=0; n<nodelist.size(); n++)
     {
-        while (fp.Fgets(buf, sizeof(buf)))
-        {
-            char* key;
-            char* val=buf;
-            getkeyval(&key, &val);
-            key = strxcpy(newpath, strbtrim(key), sizeof(Path));
-            _MapPath(key);
-            strchg(key, GOLD_WRONG_SLASH_CHR, GOLD_SLASH_CHR);
-            for(n=0; n<nodelist.size(); n++)
-            {
-                if(strieql(nodelist[n].fn, key))
-                {
-                    nodelist[n].ft = atol(val);
-                    break;
-                }
-            }
-            for(n=0; n<userlist.size(); n++)
-            {
-                if(strieql(userlist[n].fn, key))
-                {
-                    userlist[n].ft = atol(val);
-                    break;
-                }
-            }
-        }
-        fp.Fclose();
+        if(not nodediff[n].empty())
+            apply_nodediffs(nodelist[n], nodediff[n].c_str());
     }
-    else
+
+    // Get timestamps from .GXL and .GXS files
+    if(not read_stamps(listindex.c_str(), nodelist, &nodefileno))
         perror("error opening .gxl file");
+    read_stamps(stampindex.c_str(), userlist, NULL);
 
-    // Check nodelists
+    // Check nodelists. A missing list only matters if it was indexed.
+    uint missing = 0;
     for(n=0,compilen=0; n<nodelist.size(); n++)
     {
-        if(abs(long(GetFiletime(nodelist[n].fn) - nodelist[n].ft)) > 1)
+        if(not fexist(nodelist[n].fn))
+        {
+            if(nodefileno[n] != gxl_none)
+            {
+                nodelist[n].fc = YES;
+                missing++;
+            }
+        }
+        else if(abs(long(GetFiletime(nodelist[n].fn) - nodelist[n].ft)) > 1)
         {
             nodelist[n].fc = YES;
             compilen++;
@@ -1216,16 +1666,20 @@ static void check_nodelists(bool force)
         {
             std::cout << "* " << compilen << " new nodelist file" << ((compilen == 1) ? "" : "s") << " found." NL;
         }
-        else if(nodelist.size())
+        else if(nodelist.size() and not missing)
         {
             std::cout << "* The nodelist file" << ((nodelist.size() == 1) ? " is" : "s are") << " up-to-date." NL;
         }
+        if(missing)
+        {
+            std::cout << "* " << missing << " indexed nodelist file" << ((missing == 1) ? " is" : "s are") << " missing." NL;
+        }
     }
 
     // Check userlists
     for(n=0,compileu=0; n<userlist.size(); n++)
     {
-        if(abs(long(GetFiletime(newpath) - userlist[n].ft)) > 1)
+        if(abs(long(GetFiletime(userlist[n].fn) - userlist[n].ft)) > 1)
         {
             userlist[n].fc = YES;
             compileu++;
@@ -1244,8 +1698,8 @@ static void check_nodelists(bool force)
         }
     }
 
-    if(force or compilen or compileu)
-        read_nodelists();
+    if(force or compilen or missing or compileu)
+        read_nodelists(not force);
 }
 
 
@@ -1463,8 +1917,17 @@ static int parse_config(const char *__configfile, Addr& zoneaddr)
                         strcpy(ndl.fn, value);
                         nodelist.push_back(ndl);
                         nodezone.push_back(ndz);
+                        nodediff.push_back("");
                     }
                     break;
+                    case CRC_NODEDIFF:
+                        if(not nodediff.empty())
+                        {
+                            strschg_environ(value, top_buf-value);
+                            _MapPath(value);
+                            nodediff.back() = value;
+                        }
+                        break;
                     case CRC_USERLIST:
                     {
                         Stamp ndl;
@@ -1654,6 +2117,7 @@ static bool read_config(const char *cfg, const char *argv_0)
 
     AddBackslash(nodepath);
     MakePathname(listindex, nodepath, "goldnode.gxl");
+    MakePathname(stampindex, nodepath, "goldnode.gxs");
     MakePathname(nodeindex, nodepath, "goldnode.gxn");
     MakePathname(addrindex, nodepath, "goldnode.gxa");
     size_t n;
@@ -1661,6 +2125,11 @@ static bool read_config(const char *cfg, const char *argv_0)
         MakePathname(nodelist[n].fn, nodepath.c_str(), nodelist[n].fn);
     for(n=0; n<userlist.size(); n++)
         MakePathname(userlist[n].fn, nodepath.c_str(), userlist[n].fn);
+    for(n=0; n<nodediff.size(); n++)
+    {
+        if(not nodediff[n].empty())
+            MakePathname(nodediff[n], nodepath, nodediff[n]);
+    }
 
     return true;
 }